@@ -26,7 +26,6 @@ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 #include "Drtd.hpp"
-#include <FL/Fl.H>
 #include <alsa/asoundlib.h>
 #include <cassert>
 #include <csignal>
@@ -35,25 +34,39 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <decoder/dtmf/Dtmf.hpp>
 #include <decoder/null/Null.hpp>
 #include <decoder/pocsag/Pocsag.hpp>
+#include <decoder/rtty/MultiRtty.hpp>
 #include <decoder/rtty/Rtty.hpp>
 #include <memory>
 #include <stdio.h>
 #include <thread/SoundCardThread.hpp>
 #include <thread/StdinThread.hpp>
-#include <ui/BiquadFilterDialog.hpp>
-#include <ui/ConfigDialog.hpp>
-#include <ui/FirFilterDialog.hpp>
-#include <ui/IQMixerDialog.hpp>
-#include <ui/MainGui.hpp>
-#include <ui/MovingAverageDialog.hpp>
-#include <ui/WaterfallDialog.hpp>
-#include <ui/component/Waterfall.hpp>
 #include <util/Config.hpp>
-#include <util/DrtdIcon.cpp>
+#include <util/FFT.hpp>
 #include <util/Logger.hpp>
 #include <util/Util.hpp>
 #include <vector>
 
+#ifndef DRTD_HEADLESS
+#    include <FL/Fl.H>
+#    include <FL/Fl_RGB_Image.H>
+#    include <decoder/ax25/Ax25Ui.hpp>
+#    include <decoder/dcf77/Dcf77Ui.hpp>
+#    include <decoder/dtmf/DtmfUi.hpp>
+#    include <decoder/null/NullUi.hpp>
+#    include <decoder/pocsag/PocsagUi.hpp>
+#    include <decoder/rtty/MultiRttyUi.hpp>
+#    include <decoder/rtty/RttyUi.hpp>
+#    include <ui/BiquadFilterDialog.hpp>
+#    include <ui/ConfigDialog.hpp>
+#    include <ui/FirFilterDialog.hpp>
+#    include <ui/IQMixerDialog.hpp>
+#    include <ui/MainGui.hpp>
+#    include <ui/MovingAverageDialog.hpp>
+#    include <ui/WaterfallDialog.hpp>
+#    include <ui/component/Waterfall.hpp>
+#    include <util/DrtdIcon.cpp>
+#endif
+
 struct Options {
     static constexpr i8 input_none_specified = -1;
     static constexpr i8 input_show_available = -2;
@@ -64,12 +77,20 @@ struct Options {
     u8 headless_decoder_index { 0 };
     i8 input_index { input_none_specified };
     Util::Buffer<std::string> decoder_parameters {};
+    std::string address_filter_file {};
+    std::string callsign_filter_file {};
     bool ui_mode { true };
+#ifndef DRTD_HEADLESS
+    bool opengl_waterfall { true };
+    u32 max_text_lines { 10000 };
+#endif
 };
 
 constexpr const char* s_conf_audioline = "Drtd.AudioLine";
+#ifndef DRTD_HEADLESS
 constexpr const char* s_conf_main_window = "Drtd.MainGui";
 constexpr const char* s_conf_decoder_index = "Drtd.LastUsedDecoderIndex";
+#endif
 constexpr const char* s_default_line_name = "default";
 const Util::Logger s_log("drtd");
 
@@ -81,24 +102,52 @@ Buffer<std::shared_ptr<Dsp::DecoderBase>> make_decoder_buffer(Ts&&... ts) {
 Buffer<std::shared_ptr<Dsp::DecoderBase>> s_decoders;
 u8 s_audio_line_index { 0 };
 u8 s_active_decoder_index { 0 };
-Ui::MainGui* s_main_gui { nullptr };
 Buffer<Drtd::AudioLine> s_audio_lines;
 std::unique_ptr<Dsp::ProcessingThread> s_processing_thread;
 Options s_options;
 Drtd::AudioLine s_default_audio_line;
+
+#ifndef DRTD_HEADLESS
+Ui::MainGui* s_main_gui { nullptr };
 Fl_RGB_Image s_drtd_icon(drtd_icon_data.pixel_data, drtd_icon_data.width, drtd_icon_data.height, drtd_icon_data.bytes_per_pixel);
 
 Fl_RGB_Image* Drtd::drtd_icon() {
     return &s_drtd_icon;
 }
 
-void Drtd::monitor_sample(float sample) {
-    Drtd::main_gui().monitor(sample);
+bool Drtd::opengl_waterfall() {
+    return s_options.opengl_waterfall;
 }
 
-bool Drtd::using_ui() {
+u32 Drtd::max_text_lines() {
+    return s_options.max_text_lines;
+}
+
+Drtd::UserInterface* Drtd::user_interface() {
     return s_main_gui;
 }
+#else
+Drtd::UserInterface* Drtd::user_interface() {
+    return nullptr;
+}
+#endif
+
+bool Drtd::using_ui() {
+    return user_interface();
+}
+
+void Drtd::monitor_sample(float sample) {
+    if (auto* ui = user_interface())
+        ui->monitor(sample);
+}
+
+const std::string& Drtd::address_filter_file() {
+    return s_options.address_filter_file;
+}
+
+const std::string& Drtd::callsign_filter_file() {
+    return s_options.callsign_filter_file;
+}
 
 std::shared_ptr<Dsp::DecoderBase> Drtd::active_decoder() {
     return s_decoders[s_active_decoder_index];
@@ -116,10 +165,12 @@ const Util::Buffer<Drtd::AudioLine>& Drtd::audio_lines() {
     return s_audio_lines;
 }
 
+#ifndef DRTD_HEADLESS
 Ui::MainGui& Drtd::main_gui() {
     assert(s_main_gui);
     return *s_main_gui;
 }
+#endif
 
 void Drtd::for_each_decoder(std::function<void(Dsp::DecoderBase&)> callback) {
     for (auto& decoder : s_decoders)
@@ -144,23 +195,19 @@ bool Drtd::start_processing(u8 index) {
     auto& decoder = s_decoders[s_active_decoder_index];
     s_log.info() << "start_processing(): Decoder \"" << decoder->name() << "\" S/R " << decoder->input_sample_rate();
 
+#ifndef DRTD_HEADLESS
     if (using_ui()) {
         auto& gui = main_gui();
         gui.set_status("Ready.");
         gui.hide_snr();
     }
+#endif
 
     decoder->setup();
-    if (using_ui()) {
-        auto& gui = main_gui();
-        const int min_window_height = std::max(static_cast<int>(Ui::MainGui::default_window_height),
-                                               Ui::MainGui::window_padding + decoder->min_ui_height());
-        gui.size_range(Ui::MainGui::default_window_width, min_window_height);
-        gui.set_min_content_box_height(decoder->min_ui_height());
-        gui.waterfall().set_decoder(decoder);
-        decoder->load_ui_settings();
-        gui.update_decoder();
-    }
+#ifndef DRTD_HEADLESS
+    if (using_ui())
+        main_gui().use_decoder(decoder);
+#endif
 
     if (s_options.read_stdin) {
         s_log.info() << "Using StdinThread";
@@ -189,16 +236,20 @@ bool Drtd::start_processing(u8 index) {
 void Drtd::stop_processing() {
     if (s_processing_thread) {
         s_log.info() << "stop_processing()";
+#ifndef DRTD_HEADLESS
         Ui::FirFilterDialog::close_dialog();
         Ui::BiquadFilterDialog::close_dialog();
         Ui::MovingAverageDialog::close_dialog();
         Ui::IQMixerDialog::close_dialog();
+#endif
 
         s_processing_thread->request_stop_and_wait();
         auto& decoder = s_decoders[s_active_decoder_index];
         decoder->tear_down();
+#ifndef DRTD_HEADLESS
         if (using_ui())
-            decoder->save_ui_settings();
+            main_gui().save_decoder_settings(*decoder);
+#endif
 
         s_processing_thread.reset();
     }
@@ -213,15 +264,25 @@ void print_usage_and_exit(const char* error_message) {
     if (error_message)
         printf("%s\n\n", error_message);
 
+#ifdef DRTD_HEADLESS
+    puts("Usage: drtd-headless -g <Decoder> [Options] [Decoder settings]");
+#else
     puts("Usage: drtd [Options] [Decoder settings]");
+#endif
     puts("Options:");
     puts("    -g, --headless <Decoder>        Headless mode using the specified decoder.\n"
          "                                    Specify none to show available decoders.\n"
          "                                    Leave parameters empty to show available arguments");
     puts("    -i, --input <Device index>      Use specific audio input device. Specify \"-1\" to show all available devices");
     puts("    -s, --stdin <Sample rate>       Read samples directly from stdin sampled using the specified sample rate");
+    puts("    -f, --address-filter <File>     Only show POCSAG messages to the addresses in the filter file");
+    puts("    -c, --callsign-filter <File>    Only show AX.25 frames from or to the callsigns in the filter file");
     puts("        --s16                       When reading from stdin: Samples are 16 bits wide, not default 8");
     puts("        --big-endian                When reading from stdin: Endianess of samples > 8 bit is big");
+#ifndef DRTD_HEADLESS
+    puts("        --no-opengl                 Draw the waterfall without OpenGL");
+    puts("        --max-lines <Lines>         Lines of decoded text kept in the UI, default 10000");
+#endif
     puts("    -v                              Show debug messages");
     puts("    -h, --help                      Show this help");
 
@@ -299,6 +360,19 @@ void parse_options(int argc, char** argv) {
             s_options.samples_size = Dsp::StdinThread::SampleSize::S16;
         } else if (!strcmp(arg, "--big-endian")) {
             s_options.input_big_endian = true;
+#ifndef DRTD_HEADLESS
+        } else if (!strcmp(arg, "--no-opengl")) {
+            s_options.opengl_waterfall = false;
+        } else if (!strcmp(arg, "--max-lines")) {
+            if (!has_next)
+                print_usage_and_exit("Line count has to be specified!");
+
+            const int max_lines = atoi(argv[++i]);
+            if (max_lines <= 0)
+                print_usage_and_exit("Line count is in invalid range!");
+
+            s_options.max_text_lines = static_cast<u32>(max_lines);
+#endif
         } else if (!strcmp(arg, "-i") || !strcmp(arg, "--input")) {
             if (!has_next)
                 print_usage_and_exit("Input index has to be specified!");
@@ -324,6 +398,16 @@ void parse_options(int argc, char** argv) {
 
             s_options.input_sample_rate = static_cast<SampleRate>(sample_rate);
             s_options.read_stdin = true;
+        } else if (!strcmp(arg, "-f") || !strcmp(arg, "--address-filter")) {
+            if (!has_next)
+                print_usage_and_exit("Address filter file has to be specified!");
+
+            s_options.address_filter_file = argv[++i];
+        } else if (!strcmp(arg, "-c") || !strcmp(arg, "--callsign-filter")) {
+            if (!has_next)
+                print_usage_and_exit("Callsign filter file has to be specified!");
+
+            s_options.callsign_filter_file = argv[++i];
         } else if (strcmp(arg, "-v")) {
             if (s_options.ui_mode) {
                 printf("Unrecognized option \"%s\"!\n", arg);
@@ -335,6 +419,11 @@ void parse_options(int argc, char** argv) {
         }
     }
 
+#ifdef DRTD_HEADLESS
+    if (s_options.ui_mode)
+        print_usage_and_exit("Decoder has to be specified!");
+#endif
+
     if (!decoder_args.empty()) {
         s_options.decoder_parameters = Util::Buffer<std::string>(decoder_args.size());
         for (size_t i = 0; i < decoder_args.size(); ++i)
@@ -403,6 +492,7 @@ void get_available_audio_lines() {
 void handle_sigint(int) {
     s_log.info() << "Received SIGINT, stopping...";
     Drtd::stop_processing();
+    Util::FFT::save_wisdom();
     puts("Bye.");
     exit(0);
 }
@@ -415,6 +505,7 @@ int main(int argc, char** argv) {
     s_decoders = make_decoder_buffer(Dsp::Null(),
                                      Dsp::Ax25(),
                                      Dsp::Rtty(),
+                                     Dsp::MultiRtty(),
                                      Dsp::Pocsag(),
                                      Dsp::Dtmf(),
                                      Dsp::Dcf77());
@@ -422,6 +513,7 @@ int main(int argc, char** argv) {
     parse_options(argc, argv);
     Util::Config::setup(argv[0]);
     Util::Config::load_file();
+    Util::FFT::load_wisdom();
 
     if (!s_options.read_stdin) {
         get_available_audio_lines();
@@ -450,9 +542,17 @@ int main(int argc, char** argv) {
         s_log.info() << "Using audio line with index " << static_cast<int>(s_audio_line_index) << ": " << s_audio_lines[s_audio_line_index].name;
     }
 
-    int result = 0;
+#ifndef DRTD_HEADLESS
     if (s_options.ui_mode) {
         s_log.info() << "Starting in GUI mode";
+        /* Same order as above, the index of the last used decoder is saved */
+        s_decoders = make_decoder_buffer(Dsp::NullUi(),
+                                         Dsp::Ax25Ui(),
+                                         Dsp::RttyUi(),
+                                         Dsp::MultiRttyUi(),
+                                         Dsp::PocsagUi(),
+                                         Dsp::DtmfUi(),
+                                         Dsp::Dcf77Ui());
         Fl::lock(); //Enable fltk multi thread locking
 
         Ui::MainGui::WindowProperties properties;
@@ -472,7 +572,7 @@ int main(int argc, char** argv) {
                 Util::die("Could not start decoder. Outdated config file?");
         }
 
-        result = Fl::run();
+        const int result = Fl::run();
 
         Drtd::stop_processing();
         properties.position = { main_gui.x(), main_gui.y() };
@@ -482,44 +582,48 @@ int main(int argc, char** argv) {
         Util::Config::save(s_conf_main_window, properties);
         Util::Config::save(s_conf_audioline, s_audio_line_index);
         Util::Config::save_all();
-    } else {
-        s_log.info() << "Starting in headless mode";
-        auto& decoder = s_decoders[s_options.headless_decoder_index];
-        auto available_params = decoder->changeable_parameters();
-        auto print_params_and_exit = [](const Util::Buffer<std::string>& params, const char* error) {
-            printf("Invalid decoder settings!\nAvailable settings: ");
-            if (params.size()) {
-                putchar('[');
-                bool print_seperator = false;
-
-                for (auto& str : params) {
-                    if (print_seperator)
-                        printf("] [");
-
-                    printf("%s", str.c_str());
-                    print_seperator = true;
-                }
-
-                puts("]");
-            } else {
-                puts("None");
+        Util::FFT::save_wisdom();
+        return result;
+    }
+#endif
+
+    s_log.info() << "Starting in headless mode";
+    auto& decoder = s_decoders[s_options.headless_decoder_index];
+    auto available_params = decoder->changeable_parameters();
+    auto print_params_and_exit = [](const Util::Buffer<std::string>& params, const char* error) {
+        printf("Invalid decoder settings!\nAvailable settings: ");
+        if (params.size()) {
+            putchar('[');
+            bool print_seperator = false;
+
+            for (auto& str : params) {
+                if (print_seperator)
+                    printf("] [");
+
+                printf("%s", str.c_str());
+                print_seperator = true;
             }
 
-            print_usage_and_exit(error);
-        };
+            puts("]");
+        } else {
+            puts("None");
+        }
 
-        if (available_params.size() != s_options.decoder_parameters.size())
-            print_params_and_exit(available_params, "Settings count mismatch!");
+        print_usage_and_exit(error);
+    };
 
-        if (!decoder->setup_parameters(s_options.decoder_parameters))
-            print_params_and_exit(available_params, "Invalid settings value provided!");
+    if (available_params.size() != s_options.decoder_parameters.size())
+        print_params_and_exit(available_params, "Settings count mismatch!");
 
-        if (!Drtd::start_processing(s_options.headless_decoder_index))
-            Util::die("Could not start decoder! Outdated save file? Unsupported input device?");
+    if (!decoder->setup_parameters(s_options.decoder_parameters))
+        print_params_and_exit(available_params, "Invalid settings value provided!");
 
-        s_log.info() << "Joining processing thread";
-        s_processing_thread->join();
-    }
+    if (!Drtd::start_processing(s_options.headless_decoder_index))
+        Util::die("Could not start decoder! Outdated save file? Unsupported input device?");
+
+    s_log.info() << "Joining processing thread";
+    s_processing_thread->join();
+    Util::FFT::save_wisdom();
 
-    return result;
+    return 0;
 }
@@ -27,12 +27,14 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 #pragma once
 
-#include <FL/Fl_RGB_Image.H>
+#include "UserInterface.hpp"
 #include <functional>
 #include <memory>
 #include <string>
 #include <util/Types.hpp>
 
+class Fl_RGB_Image;
+
 namespace Ui {
 class MainGui;
 }
@@ -54,10 +56,8 @@ struct AudioLine {
     std::string description { "" };
 };
 
-Fl_RGB_Image* drtd_icon();
 u8 active_decoder_index();
 bool using_ui();
-Ui::MainGui& main_gui();
 bool use_decoder(u8 index);
 bool start_processing(u8 index);
 void stop_processing();
@@ -67,6 +67,15 @@ u8 current_audio_line();
 const Util::Buffer<Drtd::AudioLine>& audio_lines();
 void for_each_decoder(std::function<void(Dsp::DecoderBase&)> callback);
 std::shared_ptr<Dsp::DecoderBase> active_decoder();
+const std::string& address_filter_file();
+const std::string& callsign_filter_file();
+
+/* nullptr when running headless or with -g */
+UserInterface* user_interface();
 void monitor_sample(float sample);
+Fl_RGB_Image* drtd_icon();
+Ui::MainGui& main_gui();
+bool opengl_waterfall();
+u32 max_text_lines();
 
 }
@@ -0,0 +1,77 @@
+/*
+BSD 2-Clause License
+
+Copyright (c) 2020, Till Mayer
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#pragma once
+
+#include <string>
+#include <util/Types.hpp>
+
+namespace Pipe {
+template<typename RefType>
+class ConfigRef;
+}
+
+namespace Dsp {
+class FirFilterBase;
+class IQMixer;
+class MovingAverageBase;
+
+namespace Biquad {
+class FilterBase;
+}
+}
+
+namespace Drtd {
+
+/* What the pipeline and the decoders show in the user interface. It is implemented by the main window, headless mode has none */
+class UserInterface {
+public:
+    virtual ~UserInterface() = default;
+
+    virtual void monitor(float sample) = 0;
+    virtual void set_monitor_sample_rate(SampleRate) = 0;
+    /* The waterfall marker only makes sense while the decoder input is monitored */
+    virtual void show_marker(bool) = 0;
+    virtual void show_message(const std::string&) = 0;
+
+    virtual void set_status(const std::string&) = 0;
+    virtual void update_snr(float) = 0;
+    virtual void update_center_frequency() = 0;
+    virtual void redraw_waterfall() = 0;
+
+    virtual void show_config_dialog(Pipe::ConfigRef<Dsp::Biquad::FilterBase>) = 0;
+    virtual void show_config_dialog(Pipe::ConfigRef<Dsp::FirFilterBase>) = 0;
+    virtual void show_config_dialog(Pipe::ConfigRef<Dsp::IQMixer>) = 0;
+    virtual void show_config_dialog(Pipe::ConfigRef<Dsp::MovingAverageBase>) = 0;
+    /* Called whenever a component changes, the dialog showing it has to be updated */
+    virtual void update_config_dialog(const Dsp::Biquad::FilterBase&) = 0;
+    virtual void update_config_dialog(const Dsp::FirFilterBase&) = 0;
+    virtual void update_config_dialog(const Dsp::IQMixer&) = 0;
+    virtual void update_config_dialog(const Dsp::MovingAverageBase&) = 0;
+};
+
+}
@@ -30,8 +30,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "DecoderBase.hpp"
 #include <memory>
 #include <pipe/Line.hpp>
-#include <ui/MainGui.hpp>
-#include <ui/component/Waterfall.hpp>
+#include <util/UiLock.hpp>
 
 namespace Dsp {
 
@@ -54,8 +53,10 @@ public:
             return false;
 
         bool result = Pipe::ComponentBase<T, T>::clicked_component(clicked_at, event);
-        if (result && event == Pipe::ClickEvent::MonitorOutput && !m_output)
-            Drtd::main_gui().waterfall().show_marker(true);
+        if (result && event == Pipe::ClickEvent::MonitorOutput && !m_output) {
+            if (auto* ui = Drtd::user_interface())
+                ui->show_marker(true);
+        }
         return result;
     }
 
@@ -64,12 +65,12 @@ protected:
         return *this;
     }
 
-    virtual void draw_at(Point p) override {
+    virtual void draw_at(Painter& painter, Point p) override {
         auto size = calculate_size();
-        fl_rect(p.x(), p.y(), size.w(), size.h());
+        painter.rect(p.x(), p.y(), size.w(), size.h());
         size.resize(-1, -1);
-        fl_line(p.x(), p.y(), p.x() + size.w(), p.y() + size.h());
-        fl_line(p.x(), p.y() + size.h(), p.x() + size.w(), p.y());
+        painter.line(p.x(), p.y(), p.x() + size.w(), p.y() + size.h());
+        painter.line(p.x(), p.y() + size.h(), p.x() + size.w(), p.y());
     }
 
 private:
@@ -102,10 +103,8 @@ public:
         PipelineResult result = m_pipeline->run(value);
 
         if (!Pipe::GenericComponent::did_abort_processing()) {
-            Fl::lock();
+            Util::UiLock lock;
             process_pipeline_result(result);
-            Fl::awake();
-            Fl::unlock();
         }
     }
 
@@ -120,19 +119,9 @@ public:
         int id = 0;
         m_pipeline->init(input_sample_rate(), id);
         on_setup();
-        if (Drtd::using_ui()) {
-            static constexpr u8 decoder_ui_padding = 8;
-
+        /* The waterfall shows the decoder input */
+        if (Drtd::using_ui())
             in_ref->monitor(Pipe::Monitor::Output);
-            auto& content_box = Drtd::main_gui().content_box();
-            content_box.clear();
-            auto* root = build_ui({ content_box.x() + decoder_ui_padding, content_box.y() + decoder_ui_padding },
-                                  { static_cast<unsigned>(content_box.w() - 2 * decoder_ui_padding),
-                                    static_cast<unsigned>(content_box.h() - 2 * decoder_ui_padding) });
-            content_box.add(root);
-            content_box.resizable(root);
-            content_box.redraw();
-        }
     }
 
     virtual void tear_down() final override {
@@ -151,7 +140,6 @@ public:
 protected:
     virtual void on_tear_down() {};
     virtual Pipe::Line<float, PipelineResult> build_pipeline() = 0;
-    virtual Fl_Widget* build_ui(Point top_left, Size ui_size) = 0;
     virtual void process_pipeline_result(PipelineResult) = 0;
     virtual void on_setup() {}
 
@@ -27,31 +27,12 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 #include "Decoder.hpp"
 #include <Drtd.hpp>
-#include <ui/MainGui.hpp>
-#include <ui/component/Waterfall.hpp>
-#include <util/Config.hpp>
 
 using namespace Dsp;
 
-constexpr const char* conf_waterfall_settings { "Base.WaterfallSettings" };
-constexpr const char* conf_center_frequency { "Base.CenterFrequency" };
-
-void DecoderBase::save_ui_settings() {
-    Util::Config::save(config_path(conf_waterfall_settings), Drtd::main_gui().waterfall().settings());
-    Util::Config::save(config_path(conf_center_frequency), m_center_frequency);
-}
-
-void DecoderBase::load_ui_settings() {
-    auto settings = Drtd::main_gui().waterfall().settings();
-    Util::Config::load(config_path(conf_waterfall_settings), settings, settings);
-    Drtd::main_gui().waterfall().update_settings_later(settings);
-    Util::Config::load(config_path(conf_center_frequency), m_center_frequency, m_center_frequency);
-    set_center_frequency(m_center_frequency);
-}
-
 void DecoderBase::update_snr(float snr) {
-    if (Drtd::using_ui())
-        Drtd::main_gui().update_snr(snr);
+    if (auto* ui = Drtd::user_interface())
+        ui->update_snr(snr);
 }
 
 void DecoderBase::set_marker(Util::MarkerGroup marker) {
@@ -65,19 +46,19 @@ void DecoderBase::set_marker(Util::MarkerGroup marker) {
     }
 
     m_center_frequency = std::max(m_center_frequency, m_min_center_frequency);
-    if (Drtd::using_ui())
-        Drtd::main_gui().waterfall().force_redraw();
+    if (auto* ui = Drtd::user_interface())
+        ui->redraw_waterfall();
 }
 
 void DecoderBase::set_center_frequency(Hertz center_frequency) {
     m_center_frequency = std::clamp(center_frequency, m_min_center_frequency, static_cast<Hertz>(m_input_sample_rate / 2));
-    if (Drtd::using_ui()) {
-        Drtd::main_gui().update_center_frequency();
+    if (auto* ui = Drtd::user_interface()) {
+        ui->update_center_frequency();
         on_marker_move(center_frequency);
     }
 }
 
 void DecoderBase::set_status(const std::string& status) {
-    if (Drtd::using_ui())
-        Drtd::main_gui().set_status(status);
+    if (auto* ui = Drtd::user_interface())
+        ui->set_status(status);
 }
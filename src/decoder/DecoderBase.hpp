@@ -32,6 +32,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <util/Buffer.hpp>
 #include <util/Marker.hpp>
 
+class Fl_Widget;
+
 namespace Dsp {
 
 class DecoderBase {
@@ -72,8 +74,6 @@ public:
 
     DecoderBase& operator=(DecoderBase&& other) = delete;
 
-    void save_ui_settings();
-    void load_ui_settings();
     std::string name() const { return m_name; }
     u16 input_sample_rate() const { return m_input_sample_rate; }
     bool headless() const { return m_headless == Headless::Yes; }
@@ -91,9 +91,12 @@ public:
     virtual Util::Buffer<std::string> changeable_parameters() const = 0;
     virtual bool setup_parameters(const Util::Buffer<std::string>&) = 0;
     virtual Pipe::GenericComponent& pipeline() = 0;
+    /* Only the decoders built for the UI have one, see Drtd.cpp */
+    virtual Fl_Widget* build_ui(Point, Size) { return nullptr; }
 
-protected:
     std::string config_path(const std::string& property_name) const { return m_config_path + '.' + property_name; }
+
+protected:
     const Logger& logger() const { return m_log; }
     void set_marker(Util::MarkerGroup);
     virtual void on_marker_move([[maybe_unused]] Hertz center_frequency) {}
@@ -27,13 +27,12 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 #include "Address.hpp"
 #include <cassert>
-#include <sstream>
 
 using namespace Dsp::AX25Protocol;
 
-Address::Address(Type type, std::string name, u8 ssid, u8 reserved, bool cbit, bool end_byte)
+Address::Address(Type type, const std::array<char, name_size>& name, u8 ssid, u8 reserved, bool cbit, bool end_byte)
     : m_type(type)
-    , m_name(std::move(name))
+    , m_name(name)
     , m_ssid(ssid)
     , m_reserved(reserved)
     , m_cbit(cbit)
@@ -42,34 +41,34 @@ Address::Address(Type type, std::string name, u8 ssid, u8 reserved, bool cbit, b
 
 Address::Address()
     : m_type(Type::Invalid)
-    , m_name("INVALID")
+    , m_name()
     , m_ssid()
     , m_reserved()
     , m_cbit()
     , m_end_byte() {
 }
 
-std::optional<Address> Address::parse(Type type, const std::vector<u8>& bytes, unsigned offset) {
-    if (bytes.size() <= offset + Address::address_block_size)
+std::optional<Address> Address::parse(Type type, const u8* bytes, size_t size, size_t offset) {
+    if (size <= offset + Address::address_block_size)
         return {};
 
-    std::ostringstream builder;
-    for (unsigned i = offset; i < offset + Address::address_block_size - 1; ++i) {
-        builder << static_cast<char>(bytes[i] >> 1);
-        if (mask_hdlc & bytes[i])
+    std::array<char, name_size> name;
+    for (u8 i = 0; i < name_size; ++i) {
+        name[i] = static_cast<char>(bytes[offset + i] >> 1);
+        if (mask_hdlc & bytes[offset + i])
             return {};
     }
 
     u8 ssid = bytes[offset + Address::address_block_size - 1];
     return Address(type,
-                   builder.str(),
+                   name,
                    ssid >> 1 & 0xF,
                    ssid >> 5 & 0x3,
                    ssid & mask_cbit,
                    ssid & mask_hdlc);
 }
 
-std::string Address::name_for_type(Type type) {
+const char* Address::name_for_type(Type type) {
     switch (type) {
     case Type::Destination:
         return "Destination";
@@ -81,7 +80,7 @@ std::string Address::name_for_type(Type type) {
         return "Invalid";
     }
     assert(false);
-    return {};
+    return "";
 }
 
 bool Address::is_command() const {
@@ -92,18 +91,17 @@ bool Address::is_repeated() const {
     return m_type == Type::Repeater && m_cbit;
 }
 
-std::string Address::format() const {
-    std::ostringstream builder;
+void Address::format(Util::FixedStringBuilder& builder) const {
+    builder.append('"');
+    builder.append(name());
+    builder.append('"');
 
-    builder << "\"" << name() << "\"";
     if (is_repeated())
-        builder << "[Rpt]";
+        builder.append("[Rpt]");
     else if (is_command())
-        builder << "[Cmd]";
+        builder.append("[Cmd]");
     else
-        builder << "     ";
+        builder.append("     ");
 
-    builder << std::hex << "(0x" << static_cast<unsigned>(ssid()) << ")";
-
-    return builder.str();
+    builder.appendf("(0x%x)", static_cast<unsigned>(ssid()));
 }
@@ -27,10 +27,11 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 #pragma once
 
+#include <array>
 #include <optional>
-#include <string>
+#include <string_view>
+#include <util/FixedStringBuilder.hpp>
 #include <util/Types.hpp>
-#include <vector>
 
 namespace Dsp::AX25Protocol {
 
@@ -44,14 +45,15 @@ public:
     };
 
     static constexpr u8 address_block_size = 7;
-    static std::optional<Address> parse(Type, const std::vector<u8>& bytes, unsigned offset);
-    static std::string name_for_type(Type);
+    static constexpr u8 name_size = address_block_size - 1;
+    static std::optional<Address> parse(Type, const u8* bytes, size_t size, size_t offset);
+    static const char* name_for_type(Type);
 
     Address();
 
-    std::string format() const;
+    void format(Util::FixedStringBuilder&) const;
     Type type() const { return m_type; }
-    const std::string& name() const { return m_name; }
+    std::string_view name() const { return { m_name.data(), m_name.size() }; }
     u8 ssid() const { return m_ssid; }
     u8 reserved() const { return m_reserved; }
     bool cbit() const { return m_cbit; }
@@ -63,10 +65,10 @@ private:
     static constexpr u8 mask_hdlc = 0x01;
     static constexpr u8 mask_cbit = 0x80;
 
-    Address(Type, std::string, u8, u8, bool, bool);
+    Address(Type, const std::array<char, name_size>&, u8, u8, bool, bool);
 
     Type m_type;
-    std::string m_name;
+    std::array<char, name_size> m_name;
     u8 m_ssid;
     u8 m_reserved;
     bool m_cbit : 1;
@@ -26,206 +26,175 @@ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 #include "Ax25.hpp"
-#include "Packet.hpp"
-#include <FL/Fl_Slider.H>
+#include "PacketView.hpp"
 #include <dsp/AngleDifference.hpp>
-#include <dsp/BiquadFilterComponent.hpp>
-#include <dsp/BitConverter.hpp>
+#include <dsp/ClockRecovery.hpp>
 #include <dsp/FirFilter.hpp>
 #include <dsp/IQMixer.hpp>
-#include <dsp/Mapper.hpp>
 #include <dsp/MovingAverage.hpp>
 #include <dsp/NRZIDecoder.hpp>
-#include <ui/component/Indicator.hpp>
+#include <dsp/Tap.hpp>
+#include <pipe/Parallel.hpp>
+#include <string_view>
 #include <util/Cmplx.hpp>
+#include <util/Config.hpp>
 
 using namespace Dsp;
 
 static constexpr u16 sample_rate { 22050 };
 static constexpr u16 baud_rate { 1200 };
 
+/*
+ * The demodulators differ in the width of the channel filter, and in the slicer threshold. A threshold off
+ * zero compensates for stations that are slightly off frequency, or whose tones are not equally loud
+ * after filtering, which both shift the discriminator output.
+ */
+struct DemodulatorVariant {
+    Hertz filter_cutoff;
+    float slicer_threshold;
+};
+
+static constexpr std::array<DemodulatorVariant, 4> demodulator_variants { { { 600, 0 },
+                                                                            { 500, 0 },
+                                                                            { 600, .02f },
+                                                                            { 600, -.02f } } };
+
 Ax25::Ax25()
-    : Decoder<bool>("AX.25", sample_rate, DecoderBase::Headless::Yes, 140) {
+    : Decoder<u8>("AX.25", sample_rate, DecoderBase::Headless::Yes, 140) {
     set_marker({ { { -500, 100 }, { 500, 100 } }, false });
     set_center_frequency(1700);
 }
 
-Ax25::StateInfo Ax25::info_for_state(State state) {
-    switch (state) {
-    case State::WaitFlag:
-        return { .ignore_stuffed_bits = false,
-                 .update_indicator = false,
-                 .label = "Waiting for flag..." };
-    case State::CountFlag:
-        return { .ignore_stuffed_bits = false,
-                 .update_indicator = false,
-                 .label = "Counting flags..." };
-    case State::WaitData:
-        return { .ignore_stuffed_bits = false,
-                 .update_indicator = true,
-                 .label = "Waiting for begin of data..." };
-    case State::WaitEnd:
-        return { .ignore_stuffed_bits = true,
-                 .update_indicator = true,
-                 .label = "Reading data..." };
+void Ax25::on_setup() {
+    if (Drtd::using_ui())
+        Util::Config::load(config_path("FixBitErrors"), m_fix_bit_errors, true);
+
+    m_callsign_filter.reset();
+    if (!Drtd::callsign_filter_file().empty()) {
+        m_callsign_filter = AX25Protocol::CallsignFilter::load(Drtd::callsign_filter_file());
+        if (!m_callsign_filter.has_value() && !Drtd::using_ui())
+            Util::die("Could not load the callsign filter!");
+    }
+
+    for (auto& deframer : m_deframers) {
+        deframer.reset();
+        deframer.set_callsign_filter(m_callsign_filter.has_value() ? &m_callsign_filter.value() : nullptr);
     }
 
-    assert(false);
-    return {};
+    m_recent_frames.fill({});
+    m_sample_count = 0;
+    m_shown_state.reset();
+    update_fix_bit_errors(m_fix_bit_errors);
+    update_status();
 }
 
-void Ax25::on_setup() {
-    change_state_to(State::WaitFlag);
+void Ax25::on_tear_down() {
+    if (Drtd::using_ui())
+        Util::Config::save(config_path("FixBitErrors"), m_fix_bit_errors);
 }
 
-void Ax25::change_state_to(State new_state) {
-    m_current_state_info = info_for_state(new_state);
-    if (m_current_state_info.ignore_stuffed_bits) {
-        m_delay_buffer.reset();
-        m_processed_buffer.reset();
-        m_one_count = 0;
+void Ax25::update_fix_bit_errors(bool fix_bit_errors) {
+    m_fix_bit_errors = fix_bit_errors;
+    for (auto& deframer : m_deframers)
+        deframer.set_fix_bit_errors(fix_bit_errors);
+}
+
+void Ax25::update_status() {
+    /* Show the state of whichever deframer got the furthest */
+    const AX25Protocol::Deframer* furthest = &m_deframers[0];
+    for (const auto& deframer : m_deframers) {
+        if (deframer.state() > furthest->state())
+            furthest = &deframer;
     }
 
-    m_in_buffer.reset_bit_count();
-    m_state = new_state;
-    set_status(m_current_state_info.label);
+    if (m_shown_state == furthest->state())
+        return;
+
+    m_shown_state = furthest->state();
+    set_status(AX25Protocol::Deframer::state_label(furthest->state()));
 }
 
-Fl_Widget* Ax25::build_ui(Point top_left, Size ui_size) {
-    m_callback_manager.forget_callbacks();
-    auto* root = new Fl_Group(top_left.x(), top_left.y(), ui_size.w(), ui_size.h());
-
-    auto* controls = new Fl_Group(top_left.x(), top_left.y(), ui_size.w(), 44);
-    controls->box(FL_EMBOSSED_BOX);
-    auto control_offset = top_left.translated(4, 4);
-    Size control_size(ui_size.w() - 8, controls->h() - 8);
-
-    m_sync_indicator = new Ui::Indicator(control_offset.x(),
-                                         control_offset.y(),
-                                         40,
-                                         control_size.h(),
-                                         Ui::Indicator::yellow_on,
-                                         Ui::Indicator::yellow_off,
-                                         "Sync");
-    m_sync_indicator->set_state(false);
-
-    m_data_indicator = new Ui::Indicator(m_sync_indicator->x() + m_sync_indicator->w() + 2,
-                                         control_offset.y(),
-                                         40,
-                                         control_size.h(),
-                                         Ui::Indicator::green_on,
-                                         Ui::Indicator::green_off,
-                                         "Data");
-
-    auto* clear_button = new Fl_Button(control_offset.x() + control_size.w() - 50, control_offset.y(), 50, control_size.h(), "Clear");
-    m_callback_manager.register_callback(*clear_button, [&]() { m_text_box->clear(); });
-
-    auto* spring = new Fl_Box(clear_button->x(), clear_button->y(), 0, 0);
-    controls->resizable(spring);
-    controls->end();
-
-    top_left.translate(0, controls->h() + 2);
-    ui_size.resize(0, -controls->h() - 2);
-
-    m_text_box = new Ui::TextDisplay(top_left.x(), top_left.y(), ui_size.w(), ui_size.h());
-    m_text_box->textfont(FL_COURIER);
-    root->resizable(m_text_box);
-    root->end();
-    return root;
+/* A channel filter, FM discriminator, matched filter and clock recovery */
+static Pipe::Line<Cmplx, BitStream> demodulator_line(DemodulatorVariant variant) {
+    return Pipe::line(FirFilter<Cmplx>(WindowType::Hamming, 41, 0, variant.filter_cutoff),
+                      AngleDifference(),
+                      MovingAverage<float>(std::round(sample_rate / static_cast<float>(baud_rate))),
+                      ClockRecovery(baud_rate, true, variant.slicer_threshold),
+                      NRZIDecoder(true));
 }
 
-Pipe::Line<float, bool> Ax25::build_pipeline() {
+Pipe::Line<float, u8> Ax25::build_pipeline() {
+    static_assert(demodulator_variants.size() == demodulator_count);
+    static_assert(demodulator_count <= sizeof(u8) * 8);
+
+    /* The bits are kept here, and the result only tells which lines produced any */
+    std::function<u8(const Buffer<BitStream>&)> merge_lines = [this](const Buffer<BitStream>& lines) {
+        u8 result = 0;
+        for (size_t i = 0; i < lines.size(); ++i) {
+            m_line_streams[i] = lines[i];
+            if (!lines[i].empty())
+                result |= 1 << i;
+        }
+        return result;
+    };
+
     return Pipe::line(
+        Tap<float>([this](float) { ++m_sample_count; }),
         IQMixer(1700),
-        FirFilter<Cmplx>(WindowType::Hamming, 41, 0, 600),
-        AngleDifference(),
-        MovingAverage<float>(std::round(sample_rate / static_cast<float>(baud_rate))),
-        Mapper<float, bool>([](float sample) { return sample < 0; }),
-        BitConverter(baud_rate),
-        NRZIDecoder(true));
+        Pipe::parallel(Pipe::MergePolicy::AnyLineProduced,
+                       merge_lines,
+                       demodulator_line(demodulator_variants[0]),
+                       demodulator_line(demodulator_variants[1]),
+                       demodulator_line(demodulator_variants[2]),
+                       demodulator_line(demodulator_variants[3])));
 }
 
-void Ax25::packet_done() {
-    if (Drtd::using_ui()) {
-        m_data_indicator->set_state(false);
-        m_sync_indicator->set_state(false);
+bool Ax25::is_duplicate(const AX25Protocol::FrameBuffer& frame, u64 end_sample) {
+    const size_t hash = std::hash<std::string_view> {}(std::string_view(reinterpret_cast<const char*>(frame.data()), frame.size()));
+    for (const auto& recent_frame : m_recent_frames) {
+        if (recent_frame.hash == hash && recent_frame.end_sample + duplicate_window_samples >= end_sample)
+            return true;
     }
 
-    auto packet = AX25Protocol::Packet::parse(m_packet_buffer);
-    m_packet_buffer.clear();
-
-    if (!packet.has_value())
-        return;
+    m_recent_frames[m_next_recent_frame] = { hash, end_sample };
+    m_next_recent_frame = (m_next_recent_frame + 1) % recent_frame_count;
+    return false;
+}
 
-    if (Drtd::using_ui()) {
-        const bool autoscroll = m_text_box->should_autoscroll();
-        m_text_box->buffer()->append(packet->format().c_str());
-        if (autoscroll)
-            m_text_box->scroll_to_bottom();
-    } else {
-        puts(packet->format().c_str());
-    }
+void Ax25::show_packet(const AX25Protocol::PacketView& packet) {
+    packet.format(m_format_buffer.data(), m_format_buffer.size());
+    show_packet_text(m_format_buffer.data());
 }
 
-void Ax25::process_pipeline_result(bool bit) {
-    bool in_bit = m_delay_buffer.push(m_in_buffer.push(bit));
+void Ax25::show_packet_text(const char* text) {
+    puts(text);
+}
 
-    if (m_one_count >= 5) {
-        m_one_count = 0;
-        if (in_bit && m_state == State::WaitEnd) {
-            logger().warning() << "Expected zero is one, assuming packet is done?";
-            packet_done();
-            return;
+void Ax25::process_pipeline_result(u8 lines) {
+    bool any_synced = false;
+    std::optional<bool> shown_bit;
+
+    for (size_t i = 0; i < m_deframers.size(); ++i) {
+        auto& deframer = m_deframers[i];
+        if (lines & (1 << i)) {
+            const auto& stream = m_line_streams[i];
+            if (deframer.process_bits(stream.bits, stream.count) && !is_duplicate(deframer.frame(), m_sample_count)) {
+                auto packet = AX25Protocol::PacketView::parse(deframer.frame().data(), deframer.frame().size());
+                if (packet.has_value()) {
+                    if (deframer.fixed_bits())
+                        logger().info() << "Fixed " << static_cast<unsigned>(deframer.fixed_bits()) << " bit error(s)";
+                    show_packet(packet.value());
+                }
+            }
+
+            if (deframer.synced() && !shown_bit.has_value())
+                shown_bit = stream.newest();
         }
-    } else {
 
-        if (in_bit)
-            ++m_one_count;
-        else
-            m_one_count = 0;
-        m_processed_buffer.push(in_bit);
+        any_synced |= deframer.synced();
     }
 
-    auto in_byte = m_in_buffer.data<u8>();
-    if (m_current_state_info.update_indicator && m_data_indicator)
-        m_data_indicator->set_state(bit);
+    show_sync_state(any_synced, shown_bit.value_or(false));
 
-    switch (m_state) {
-    case State::WaitFlag:
-        if (in_byte == AX25Protocol::Packet::magic_flag) {
-            change_state_to(State::CountFlag);
-            m_header_count = 1;
-        }
-
-        break;
-    case State::CountFlag:
-        if (!m_in_buffer.aligned())
-            return;
-
-        if (in_byte == AX25Protocol::Packet::magic_flag) {
-            if (++m_header_count >= headers_needed)
-                change_state_to(State::WaitData);
-        } else {
-            m_header_count = 0;
-            change_state_to(State::WaitFlag);
-        }
-
-        break;
-    case State::WaitData:
-        if (m_sync_indicator)
-            m_sync_indicator->set_state(true);
-        if (m_in_buffer.aligned() && in_byte != AX25Protocol::Packet::magic_flag)
-            change_state_to(State::WaitEnd);
-
-        break;
-    case State::WaitEnd:
-        if (in_byte == AX25Protocol::Packet::magic_flag) {
-            change_state_to(State::WaitFlag);
-            packet_done();
-            return;
-        } else if (m_processed_buffer.aligned()) {
-            m_packet_buffer.push_back(m_processed_buffer.data<u8>());
-        }
-        break;
-    }
+    update_status();
 }
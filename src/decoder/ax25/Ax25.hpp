@@ -27,62 +27,59 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 #pragma once
 
-#include "Packet.hpp"
-#include <FL/Fl_Text_Buffer.H>
+#include "CallsignFilter.hpp"
+#include "Deframer.hpp"
+#include "PacketView.hpp"
+#include <array>
 #include <decoder/Decoder.hpp>
-#include <list>
-#include <sstream>
-#include <ui/component/Indicator.hpp>
-#include <ui/component/TextDisplay.hpp>
-#include <util/BitBuffer.hpp>
-#include <util/CallbackManager.hpp>
+#include <optional>
+#include <util/BitStream.hpp>
 
 namespace Dsp {
 
-class Ax25 final : public Decoder<bool> {
+class Ax25 : public Decoder<u8> {
 public:
     Ax25();
 
 protected:
-    virtual Fl_Widget* build_ui(Point top_left, Size ui_size) override;
-    virtual Pipe::Line<float, bool> build_pipeline() override;
-    virtual void process_pipeline_result(bool) override;
+    virtual Pipe::Line<float, u8> build_pipeline() override;
+    virtual void process_pipeline_result(u8) override;
     virtual void on_setup() override;
+    virtual void on_tear_down() override;
+    /* Without a UI, the packets are printed */
+    virtual void show_packet_text(const char*);
+    virtual void show_sync_state(bool, bool) {}
+    void update_fix_bit_errors(bool);
+
+    std::optional<AX25Protocol::CallsignFilter> m_callsign_filter;
+    bool m_fix_bit_errors { true };
 
 private:
     static constexpr SampleRate sample_rate = 22050;
     static constexpr BaudRate baud_rate = 1200;
-    static constexpr u8 headers_needed = 5;
-
-    enum class State : u8 {
-        WaitFlag,
-        CountFlag,
-        WaitData,
-        WaitEnd
-    };
+    static constexpr u8 demodulator_count = 4;
+    /* Copies of a frame from different demodulators end within a few bit times of each other */
+    static constexpr u64 duplicate_window_samples = sample_rate / 4;
+    static constexpr u8 recent_frame_count = 8;
+    static constexpr size_t format_buffer_size = 4096;
 
-    struct StateInfo {
-        bool ignore_stuffed_bits { false };
-        bool update_indicator { false };
-        const char* label { "" };
+    struct RecentFrame {
+        size_t hash;
+        u64 end_sample;
     };
 
-    static StateInfo info_for_state(State);
-    void change_state_to(State);
-    void packet_done();
+    void update_status();
+    bool is_duplicate(const AX25Protocol::FrameBuffer&, u64 end_sample);
+    void show_packet(const AX25Protocol::PacketView&);
 
-    BitBuffer<Util::PushSequence::LsbPushedFirst, 8> m_in_buffer;
-    BitBuffer<Util::PushSequence::LsbPushedFirst, 8> m_delay_buffer;
-    BitBuffer<Util::PushSequence::LsbPushedFirst, 8> m_processed_buffer;
-    unsigned m_one_count { 0 };
-    unsigned m_header_count { 0 };
-    State m_state { State::WaitFlag };
-    std::vector<uint8_t> m_packet_buffer;
-    Ui::TextDisplay* m_text_box { nullptr };
-    Ui::Indicator* m_data_indicator { nullptr };
-    Ui::Indicator* m_sync_indicator { nullptr };
-    StateInfo m_current_state_info;
-    CallbackManager m_callback_manager;
+    std::array<AX25Protocol::Deframer, demodulator_count> m_deframers {};
+    std::array<BitStream, demodulator_count> m_line_streams {};
+    std::array<RecentFrame, recent_frame_count> m_recent_frames {};
+    u8 m_next_recent_frame { 0 };
+    /* The demodulators drop and insert bits independently, so frames are timestamped with the input samples */
+    u64 m_sample_count { 0 };
+    std::array<char, format_buffer_size> m_format_buffer {};
+    std::optional<AX25Protocol::Deframer::State> m_shown_state;
 };
 
 }
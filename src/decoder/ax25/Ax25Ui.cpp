@@ -0,0 +1,101 @@
+/*
+BSD 2-Clause License
+
+Copyright (c) 2020, Till Mayer
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "Ax25Ui.hpp"
+#include <Drtd.hpp>
+#include <FL/Fl_Box.H>
+#include <FL/Fl_Button.H>
+#include <FL/Fl_Check_Button.H>
+#include <FL/Fl_Group.H>
+
+using namespace Dsp;
+
+Fl_Widget* Ax25Ui::build_ui(Point top_left, Size ui_size) {
+    m_callback_manager.forget_callbacks();
+    auto* root = new Fl_Group(top_left.x(), top_left.y(), ui_size.w(), ui_size.h());
+
+    auto* controls = new Fl_Group(top_left.x(), top_left.y(), ui_size.w(), 44);
+    controls->box(FL_EMBOSSED_BOX);
+    auto control_offset = top_left.translated(4, 4);
+    Size control_size(ui_size.w() - 8, controls->h() - 8);
+
+    m_sync_indicator = new Ui::Indicator(control_offset.x(),
+                                         control_offset.y(),
+                                         40,
+                                         control_size.h(),
+                                         Ui::Indicator::yellow_on,
+                                         Ui::Indicator::yellow_off,
+                                         "Sync");
+    m_sync_indicator->set_state(false);
+
+    m_data_indicator = new Ui::Indicator(m_sync_indicator->x() + m_sync_indicator->w() + 2,
+                                         control_offset.y(),
+                                         40,
+                                         control_size.h(),
+                                         Ui::Indicator::green_on,
+                                         Ui::Indicator::green_off,
+                                         "Data");
+
+    auto* fix_bit_errors = new Fl_Check_Button(m_data_indicator->x() + m_data_indicator->w() + 6,
+                                               control_offset.y(),
+                                               115,
+                                               control_size.h(),
+                                               "Fix bit errors");
+    fix_bit_errors->tooltip("Try to save frames with a bad FCS by flipping one or two adjacent bits");
+    fix_bit_errors->value(m_fix_bit_errors);
+    m_callback_manager.register_callback(*fix_bit_errors, [&, fix_bit_errors]() {
+        update_fix_bit_errors(static_cast<bool>(fix_bit_errors->value()));
+    });
+
+    auto* clear_button = new Fl_Button(control_offset.x() + control_size.w() - 50, control_offset.y(), 50, control_size.h(), "Clear");
+    m_callback_manager.register_callback(*clear_button, [&]() { m_text_box->clear(); });
+
+    auto* spring = new Fl_Box(clear_button->x(), clear_button->y(), 0, 0);
+    controls->resizable(spring);
+    controls->end();
+
+    top_left.translate(0, controls->h() + 2);
+    ui_size.resize(0, -controls->h() - 2);
+
+    m_text_box = new Ui::TextDisplay(top_left.x(), top_left.y(), ui_size.w(), ui_size.h());
+    m_text_box->textfont(FL_COURIER);
+    /* Switching decoders must not end drtd, so a broken filter file is only reported here */
+    if (!Drtd::callsign_filter_file().empty() && !m_callsign_filter.has_value())
+        m_text_box->append("Could not load the callsign filter, showing all frames\n");
+    root->resizable(m_text_box);
+    root->end();
+    return root;
+}
+
+void Ax25Ui::show_packet_text(const char* text) {
+    m_text_box->append(text);
+}
+
+void Ax25Ui::show_sync_state(bool synced, bool data) {
+    m_sync_indicator->set_state(synced);
+    m_data_indicator->set_state(data);
+}
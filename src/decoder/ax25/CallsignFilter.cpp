@@ -0,0 +1,129 @@
+/*
+BSD 2-Clause License
+
+Copyright (c) 2020, Till Mayer
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "CallsignFilter.hpp"
+#include "Address.hpp"
+#include <cstdlib>
+#include <fstream>
+
+using namespace Dsp::AX25Protocol;
+
+static constexpr u8 ssid_shift { Address::name_size * 8 };
+
+CallsignFilter::Key CallsignFilter::key_for_address(const u8* address) {
+    Key key = 0;
+    for (u8 i = 0; i < Address::name_size; ++i)
+        key |= static_cast<Key>(address[i] >> 1) << (i * 8);
+
+    return key | static_cast<Key>(address[Address::name_size] >> 1 & 0xF) << ssid_shift;
+}
+
+std::optional<CallsignFilter::Key> CallsignFilter::parse_callsign(const std::string& text) {
+    const auto separator = text.find('-');
+    const auto callsign = text.substr(0, separator);
+    if (callsign.empty() || callsign.size() > Address::name_size)
+        return {};
+
+    Key key = 0;
+    for (u8 i = 0; i < Address::name_size; ++i) {
+        char c = i < callsign.size() ? callsign[i] : ' ';
+        if (c >= 'a' && c <= 'z')
+            c = static_cast<char>(c - ('a' - 'A'));
+        else if (!(c >= 'A' && c <= 'Z') && !(c >= '0' && c <= '9') && c != ' ')
+            return {};
+
+        key |= static_cast<Key>(c) << (i * 8);
+    }
+
+    if (separator == std::string::npos)
+        return key;
+
+    const auto ssid = text.substr(separator + 1);
+    if (ssid == "*")
+        return key | any_ssid;
+
+    char* last = nullptr;
+    const auto value = std::strtoul(ssid.c_str(), &last, 10);
+    if (ssid.empty() || *last != '\0' || value > 15)
+        return {};
+
+    return key | static_cast<Key>(value) << ssid_shift;
+}
+
+std::optional<CallsignFilter> CallsignFilter::load(const std::string& path) {
+    std::ifstream file(path);
+    if (!file.good()) {
+        s_log.error() << "Could not open \"" << path << '"';
+        return {};
+    }
+
+    CallsignFilter filter;
+    std::string line;
+    for (size_t line_number = 1; std::getline(file, line); ++line_number) {
+        if (!filter.parse_line(line)) {
+            s_log.error() << "Invalid entry in line " << line_number << ": \"" << line << '"';
+            return {};
+        }
+    }
+
+    s_log.info() << "Loaded \"" << path << '"';
+    return filter;
+}
+
+bool CallsignFilter::parse_line(const std::string& line) {
+    const auto first = line.find_first_not_of(" \t\r");
+    if (first == std::string::npos || line[first] == '#')
+        return true;
+
+    auto entry = line.substr(first, line.find_last_not_of(" \t\r") - first + 1);
+    const bool deny = entry[0] == '!';
+    if (deny)
+        entry.erase(0, 1);
+
+    const auto key = parse_callsign(entry);
+    if (!key.has_value())
+        return false;
+
+    (deny ? m_denied : m_allowed).insert(key.value());
+    return true;
+}
+
+bool CallsignFilter::matches(const std::unordered_set<Key>& set, const u8* address) const {
+    const Key key = key_for_address(address);
+    const Key any_ssid_key = (key & ~(static_cast<Key>(0xF) << ssid_shift)) | any_ssid;
+    return set.count(key) || set.count(any_ssid_key);
+}
+
+bool CallsignFilter::accepts(const u8* frame) const {
+    const u8* destination = frame;
+    const u8* source = frame + Address::address_block_size;
+
+    if (matches(m_denied, destination) || matches(m_denied, source))
+        return false;
+
+    return m_allowed.empty() || matches(m_allowed, destination) || matches(m_allowed, source);
+}
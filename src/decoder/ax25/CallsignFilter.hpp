@@ -0,0 +1,72 @@
+/*
+BSD 2-Clause License
+
+Copyright (c) 2020, Till Mayer
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#pragma once
+
+#include <optional>
+#include <string>
+#include <unordered_set>
+#include <util/Logger.hpp>
+#include <util/Types.hpp>
+
+namespace Dsp::AX25Protocol {
+
+/*
+ * Decides which frames are shown by their source and destination callsigns. Every line of a filter file
+ * holds a callsign with an optional SSID like "N0CALL-9", or "N0CALL-*" to match any SSID, prefixed with '!'
+ * to deny instead of allow. A callsign without an SSID only matches SSID 0. Lines starting with '#' are
+ * ignored. Without any allowing entry, everything not explicitly denied is shown.
+ */
+class CallsignFilter final {
+public:
+    /* The destination and source address blocks */
+    static constexpr u8 checked_bytes { 14 };
+
+    static std::optional<CallsignFilter> load(const std::string& path);
+
+    /* Checks the first checked_bytes bytes of a frame */
+    bool accepts(const u8* frame) const;
+
+private:
+    /* Callsign characters and SSID as they appear in an address block, with a flag for any SSID */
+    using Key = u64;
+    static constexpr Key any_ssid { static_cast<Key>(1) << 63 };
+
+    CallsignFilter() = default;
+
+    static Key key_for_address(const u8* address);
+    static std::optional<Key> parse_callsign(const std::string&);
+    bool matches(const std::unordered_set<Key>&, const u8* address) const;
+    bool parse_line(const std::string&);
+
+    static inline Logger s_log { "Callsign filter" };
+
+    std::unordered_set<Key> m_allowed;
+    std::unordered_set<Key> m_denied;
+};
+
+}
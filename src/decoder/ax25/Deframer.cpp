@@ -0,0 +1,205 @@
+/*
+BSD 2-Clause License
+
+Copyright (c) 2020, Till Mayer
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "Deframer.hpp"
+#include "FrameRepair.hpp"
+#include "PacketView.hpp"
+#include <algorithm>
+#include <cassert>
+#include <util/Logger.hpp>
+
+static Logger s_logger("AX25 Deframer");
+
+using namespace Dsp::AX25Protocol;
+
+const char* Deframer::state_label(State state) {
+    switch (state) {
+    case State::WaitFlag:
+        return "Waiting for flag...";
+    case State::CountFlag:
+        return "Counting flags...";
+    case State::WaitData:
+        return "Waiting for begin of data...";
+    case State::WaitEnd:
+        return "Reading data...";
+    }
+
+    assert(false);
+    return "";
+}
+
+void Deframer::reset() {
+    m_pending_bits = 0;
+    m_pending_count = 0;
+    m_unstuffed_bits = 0;
+    m_unstuffed_count = 0;
+    m_ones_state = 0;
+    m_header_count = 0;
+    m_frame_ready = false;
+    m_state = State::WaitFlag;
+    receive_buffer().clear();
+}
+
+bool Deframer::process_bits(u64 bits, u8 count) {
+    assert(count <= 64);
+    m_frame_ready = false;
+
+    while (count > 0) {
+        const u8 taken = std::min<u8>(count, 8 - m_pending_count);
+        m_pending_bits |= static_cast<u8>((bits & ((1u << taken) - 1)) << m_pending_count);
+        m_pending_count += taken;
+        bits >>= taken;
+        count -= taken;
+
+        if (m_pending_count == 8) {
+            process_byte(m_pending_bits);
+            m_pending_bits = 0;
+            m_pending_count = 0;
+        }
+    }
+
+    /* Frames are longer than 64 bits, so at most one can end per call */
+    return m_frame_ready;
+}
+
+void Deframer::process_byte(u8 byte) {
+    const auto& entry = s_table[m_ones_state][byte];
+    if (!entry.has_event) {
+        push_bits(entry.bits, entry.bit_count);
+        m_ones_state = entry.next_state;
+        return;
+    }
+
+    for (u8 i = 0; i < 8; ++i) {
+        const auto result = step(m_ones_state, (byte >> i) & 1);
+        push_bits(static_cast<u16>((1 << result.released_ones) - 1), result.released_ones + result.has_zero);
+        m_ones_state = result.next_state;
+        if (result.event != Event::None)
+            process_event(result.event);
+    }
+}
+
+void Deframer::push_bits(u16 bits, u8 count) {
+    if (m_state == State::WaitFlag || count == 0)
+        return;
+
+    m_unstuffed_bits |= static_cast<u32>(bits) << m_unstuffed_count;
+    m_unstuffed_count += count;
+
+    while (m_unstuffed_count >= 8 && m_state != State::WaitFlag) {
+        push_byte(static_cast<u8>(m_unstuffed_bits));
+        m_unstuffed_bits >>= 8;
+        m_unstuffed_count -= 8;
+    }
+}
+
+void Deframer::push_byte(u8 byte) {
+    switch (m_state) {
+    case State::WaitFlag:
+        break;
+    case State::CountFlag:
+        /* Only a single zero comes between two flags */
+        m_header_count = 0;
+        m_state = State::WaitFlag;
+        break;
+    case State::WaitData:
+        receive_buffer().clear();
+        m_crc.reset();
+        m_state = State::WaitEnd;
+        [[fallthrough]];
+    case State::WaitEnd:
+        if (!receive_buffer().push_back(byte)) {
+            s_logger.warning() << "Frame too long, dropping it";
+            m_header_count = 0;
+            m_state = State::WaitFlag;
+            break;
+        }
+
+        m_crc.push(byte);
+
+        /* Rejected frames are dropped as soon as both addresses are known, long before they end */
+        if (m_callsign_filter && receive_buffer().size() == CallsignFilter::checked_bytes && !m_callsign_filter->accepts(receive_buffer().data())) {
+            m_header_count = 0;
+            m_state = State::WaitFlag;
+        }
+        break;
+    }
+}
+
+void Deframer::process_event(Event event) {
+    if (event == Event::Abort) {
+        if (m_state == State::WaitEnd)
+            s_logger.warning() << "Expected zero is one, aborting packet";
+
+        m_header_count = 0;
+        m_state = State::WaitFlag;
+        return;
+    }
+
+    assert(event == Event::Flag);
+    switch (m_state) {
+    case State::WaitFlag:
+        m_header_count = 1;
+        m_state = State::CountFlag;
+        break;
+    case State::CountFlag:
+        if (m_unstuffed_count != 1)
+            m_header_count = 0;
+
+        if (++m_header_count >= headers_needed)
+            m_state = State::WaitData;
+        break;
+    case State::WaitData:
+        break;
+    case State::WaitEnd:
+        frame_done();
+        m_header_count = 1;
+        m_state = State::CountFlag;
+        break;
+    }
+
+    m_unstuffed_bits = 0;
+    m_unstuffed_count = 0;
+}
+
+void Deframer::frame_done() {
+    /* The zero starting the closing flag is passed on like data, so a whole number of bytes leaves one bit */
+    auto& buffer = receive_buffer();
+    const bool complete = m_unstuffed_count == 1
+        && buffer.size() >= PacketView::min_packet_size + PacketView::fcs_size;
+
+    m_fixed_bits = 0;
+    if (complete && !m_crc.has_good_residue() && m_fix_bit_errors)
+        m_fixed_bits = FrameRepair::repair(buffer.data(), buffer.size(), m_crc.residue());
+
+    if (!complete || (!m_crc.has_good_residue() && m_fixed_bits == 0))
+        return;
+
+    buffer.shrink(PacketView::fcs_size);
+    m_frame_index ^= 1;
+    m_frame_ready = true;
+}
@@ -0,0 +1,188 @@
+/*
+BSD 2-Clause License
+
+Copyright (c) 2020, Till Mayer
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#pragma once
+
+#include "CallsignFilter.hpp"
+#include <algorithm>
+#include <array>
+#include <util/Crc16.hpp>
+#include <util/Types.hpp>
+
+namespace Dsp::AX25Protocol {
+
+/* Frames are received into fixed buffers, longer ones are dropped */
+class FrameBuffer final {
+public:
+    static constexpr size_t capacity { 512 };
+
+    bool push_back(u8 byte) {
+        if (m_size == capacity)
+            return false;
+
+        m_bytes[m_size++] = byte;
+        return true;
+    }
+
+    void clear() { m_size = 0; }
+    void shrink(size_t count) { m_size -= std::min(count, m_size); }
+    u8* data() { return m_bytes.data(); }
+    const u8* data() const { return m_bytes.data(); }
+    size_t size() const { return m_size; }
+
+private:
+    std::array<u8, capacity> m_bytes;
+    size_t m_size { 0 };
+};
+
+/*
+ * Finds the flags, removes the stuffed bits and checks the FCS of frames in the bits of one demodulator.
+ *
+ * Bits are handled a byte at a time using a table indexed by the number of ones seen before the byte and the
+ * byte itself, which gives the unstuffed bits and the number of ones after it. Ones are only passed on once a
+ * zero follows them, so the ones of a flag or abort sequence never end up in a frame. Only bytes containing
+ * the end of a flag or an abort sequence are walked bit by bit.
+ */
+class Deframer final {
+public:
+    enum class State : u8 {
+        WaitFlag,
+        CountFlag,
+        WaitData,
+        WaitEnd
+    };
+
+    static const char* state_label(State);
+
+    /* Bits are consumed oldest first, starting at the LSB. Returns true if a frame with a good FCS ended */
+    bool process_bits(u64 bits, u8 count);
+    bool process_bit(bool bit) { return process_bits(bit, 1); }
+    void reset();
+    void set_fix_bit_errors(bool fix_bit_errors) { m_fix_bit_errors = fix_bit_errors; }
+    void set_callsign_filter(const CallsignFilter* callsign_filter) { m_callsign_filter = callsign_filter; }
+
+    /* The bytes of the last good frame between the flags, without the FCS */
+    const FrameBuffer& frame() const { return m_buffers[m_frame_index]; }
+    u8 fixed_bits() const { return m_fixed_bits; }
+    State state() const { return m_state; }
+    bool synced() const { return m_state == State::WaitData || m_state == State::WaitEnd; }
+
+private:
+    static constexpr u8 headers_needed = 5;
+
+    /* How many ones were seen last, up to five which are still held back. Six means a flag or abort may follow */
+    using OnesState = u8;
+    static constexpr OnesState six_ones { 6 };
+    static constexpr OnesState aborted { 7 };
+    static constexpr u8 ones_state_count { 8 };
+
+    enum class Event : u8 {
+        None,
+        Flag,
+        Abort
+    };
+
+    struct Step {
+        OnesState next_state;
+        Event event;
+        /* Number of ones released, followed by a zero if has_zero is set */
+        u8 released_ones;
+        bool has_zero;
+    };
+
+    static constexpr Step step(OnesState state, bool bit) {
+        if (state == aborted)
+            return { bit ? aborted : OnesState(0), Event::None, 0, false };
+
+        if (state == six_ones)
+            return { bit ? aborted : OnesState(0), bit ? Event::Abort : Event::Flag, 0, false };
+
+        if (bit)
+            return { static_cast<OnesState>(state + 1), Event::None, 0, false };
+
+        /* A zero after five ones is a stuffed bit and is dropped */
+        return { 0, Event::None, state, state < 5 };
+    }
+
+    struct TableEntry {
+        u16 bits;
+        u8 bit_count;
+        OnesState next_state;
+        bool has_event;
+    };
+
+    using Table = std::array<std::array<TableEntry, 256>, ones_state_count>;
+
+    static constexpr Table build_table() {
+        Table table {};
+        for (OnesState state = 0; state < ones_state_count; ++state) {
+            for (u16 byte = 0; byte < 256; ++byte) {
+                TableEntry entry { 0, 0, state, false };
+                for (u8 i = 0; i < 8; ++i) {
+                    const auto result = step(entry.next_state, (byte >> i) & 1);
+                    entry.has_event |= result.event != Event::None;
+                    entry.bits |= ((1 << result.released_ones) - 1) << entry.bit_count;
+                    entry.bit_count += result.released_ones + result.has_zero;
+                    entry.next_state = result.next_state;
+                }
+
+                table[state][byte] = entry;
+            }
+        }
+
+        return table;
+    }
+
+    static const Table s_table;
+
+    void process_byte(u8);
+    void process_event(Event);
+    void push_bits(u16 bits, u8 count);
+    void push_byte(u8);
+    void frame_done();
+    FrameBuffer& receive_buffer() { return m_buffers[m_frame_index ^ 1]; }
+
+    u8 m_pending_bits { 0 };
+    u8 m_pending_count { 0 };
+    u32 m_unstuffed_bits { 0 };
+    u8 m_unstuffed_count { 0 };
+    OnesState m_ones_state { 0 };
+    u8 m_fixed_bits { 0 };
+    bool m_frame_ready { false };
+    unsigned m_header_count { 0 };
+    State m_state { State::WaitFlag };
+    /* One buffer holds the last good frame while the other one receives */
+    std::array<FrameBuffer, 2> m_buffers;
+    u8 m_frame_index { 1 };
+    Util::Crc16 m_crc;
+    bool m_fix_bit_errors { true };
+    const CallsignFilter* m_callsign_filter { nullptr };
+};
+
+inline constexpr Deframer::Table Deframer::s_table { Deframer::build_table() };
+
+}
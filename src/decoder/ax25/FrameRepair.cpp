@@ -0,0 +1,65 @@
+/*
+BSD 2-Clause License
+
+Copyright (c) 2020, Till Mayer
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "FrameRepair.hpp"
+#include <util/Crc16.hpp>
+
+using namespace Dsp::AX25Protocol;
+
+u8 FrameRepair::repair(u8* frame, size_t size, u16 residue, Clock::duration time_budget) {
+    const u16 syndrome = residue ^ Util::Crc16::good_residue;
+    const size_t bit_count = size * 8;
+    if (syndrome == 0 || bit_count < 2)
+        return 0;
+
+    const auto deadline = Clock::now() + time_budget;
+
+    /* Single bit errors are checked first, as they are the less likely to be a false match */
+    for (u8 flipped_bits = 1; flipped_bits <= 2; ++flipped_bits) {
+        u16 delta = Util::Crc16::polynomial;
+        u16 following_delta = 0;
+
+        for (size_t bit = bit_count; bit-- > 0;) {
+            const u16 candidate = flipped_bits == 1 ? delta : delta ^ following_delta;
+            if (candidate == syndrome && (flipped_bits == 1 || bit + 1 < bit_count)) {
+                flip(frame, bit);
+                if (flipped_bits == 2)
+                    flip(frame, bit + 1);
+
+                return flipped_bits;
+            }
+
+            if (bit % bits_per_clock_check == 0 && Clock::now() > deadline)
+                return 0;
+
+            following_delta = delta;
+            delta = Util::Crc16::append_zero_bit(delta);
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,57 @@
+/*
+BSD 2-Clause License
+
+Copyright (c) 2020, Till Mayer
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#pragma once
+
+#include <chrono>
+#include <util/Types.hpp>
+
+namespace Dsp::AX25Protocol {
+
+/*
+ * Tries to save a frame with a bad FCS by flipping a single bit or two adjacent bits. A single bit error on
+ * air turns into two adjacent ones after NRZI decoding, so both are common on weak signals.
+ *
+ * As the CRC is linear, flipping a bit changes the residue by a value depending only on how many bits follow
+ * it. Walking the frame backwards, that value is updated with one shift per bit, so every candidate is checked
+ * with a single comparison instead of running the CRC over the whole frame again.
+ */
+class FrameRepair final {
+public:
+    using Clock = std::chrono::steady_clock;
+    static constexpr std::chrono::microseconds default_time_budget { 2000 };
+
+    /* The frame includes the FCS. Returns the number of flipped bits, or 0 if no repair was found in time */
+    static u8 repair(u8* frame, size_t size, u16 residue, Clock::duration time_budget = default_time_budget);
+
+private:
+    static constexpr size_t bits_per_clock_check = 64;
+
+    static void flip(u8* frame, size_t bit) { frame[bit / 8] ^= static_cast<u8>(1 << (bit % 8)); }
+};
+
+}
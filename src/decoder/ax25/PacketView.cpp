@@ -25,11 +25,11 @@ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
 OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
+#include "PacketView.hpp"
 #include "Address.hpp"
-#include "Packet.hpp"
 #include <chrono>
-#include <cstring>
 #include <ctime>
+#include <util/FixedStringBuilder.hpp>
 #include <util/Logger.hpp>
 #include <util/Util.hpp>
 
@@ -37,25 +37,27 @@ static Logger s_logger("AX25 Packet");
 
 using namespace Dsp::AX25Protocol;
 
-Packet::Packet(Type type,
-               Address source,
-               Address destination,
-               std::vector<Address> repeaters,
-               u8 control,
-               bool poll,
-               Buffer<u8> data,
-               PacketContents contents)
+PacketView::PacketView(Type type,
+                       Address source,
+                       Address destination,
+                       const std::array<Address, max_repeaters>& repeaters,
+                       u8 repeater_count,
+                       u8 control,
+                       bool poll,
+                       std::string_view data,
+                       PacketContents contents)
     : m_type(type)
     , m_source(source)
     , m_destination(destination)
-    , m_repeaters(std::move(repeaters))
+    , m_repeaters(repeaters)
+    , m_repeater_count(repeater_count)
     , m_control(control)
     , m_poll(poll)
-    , m_data(std::move(data))
+    , m_data(data)
     , m_contents(contents) {
 }
 
-const char* Packet::pid_by_byte(u8 byte) {
+const char* PacketView::pid_by_byte(u8 byte) {
     switch (byte) {
     case 0x01:
         return "ISO 8208/CCITT X.25 PLP ";
@@ -90,7 +92,7 @@ const char* Packet::pid_by_byte(u8 byte) {
     return "Unknown/Not yet implemented";
 }
 
-const char* Packet::receive_type_by_byte(u8 receive_type) {
+const char* PacketView::receive_type_by_byte(u8 receive_type) {
 
     switch (receive_type) {
     case 0:
@@ -104,7 +106,7 @@ const char* Packet::receive_type_by_byte(u8 receive_type) {
     return "Unknown";
 }
 
-const char* Packet::control_type_by_byte(u8 byte) {
+const char* PacketView::control_type_by_byte(u8 byte) {
     switch (byte) {
     case 0x0F:
         return "Set asynchronous balanced mode extended";
@@ -129,22 +131,42 @@ const char* Packet::control_type_by_byte(u8 byte) {
     return "Unknown control type";
 }
 
-bool Packet::uses_information(u8 byte) {
+bool PacketView::uses_information(u8 byte) {
     return byte == 0x11 || byte == 0 || byte == 0x1C || byte == 0x17 || byte == 0xFF;
 }
 
-std::optional<Packet> Packet::parse(const std::vector<u8>& bytes) {
+std::optional<u8> PacketView::read_pid(const u8* bytes, size_t size, size_t& offset) {
+    if (offset >= size)
+        return {};
+
+    u8 pid = bytes[offset++];
+    if (pid == pid_escape) {
+        if (offset >= size)
+            return {};
+
+        pid = bytes[offset++];
+    }
+
+    return pid;
+}
+
+std::string_view PacketView::data_field(const u8* bytes, size_t size, size_t offset) {
+    return { reinterpret_cast<const char*>(bytes) + offset, size - offset };
+}
+
+std::optional<PacketView> PacketView::parse(const u8* bytes, size_t size) {
     static Logger logger("AX25 Packet");
 
-    if (bytes.size() < min_packet_size) {
+    if (size < min_packet_size) {
         logger.warning() << "Packet too short";
         return {};
     }
 
-    unsigned offset = 1; //Skip 0
-    std::vector<Address> repeaters;
+    size_t offset = 0;
+    std::array<Address, max_repeaters> repeaters;
+    u8 repeater_count = 0;
 
-    auto address = Address::parse(Address::Type::Destination, bytes, offset);
+    auto address = Address::parse(Address::Type::Destination, bytes, size, offset);
     if (!address.has_value()) {
         logger.warning() << "Could not parse destination address";
         return {};
@@ -153,7 +175,7 @@ std::optional<Packet> Packet::parse(const std::vector<u8>& bytes) {
     offset += Address::address_block_size;
     Address destination = address.value();
 
-    address = Address::parse(Address::Type::Source, bytes, offset);
+    address = Address::parse(Address::Type::Source, bytes, size, offset);
     if (!address.has_value()) {
         logger.warning() << "Could not parse source address";
         return {};
@@ -163,15 +185,15 @@ std::optional<Packet> Packet::parse(const std::vector<u8>& bytes) {
     Address source = address.value();
 
     if (!source.is_end_byte()) {
-        for (unsigned i = 0; i < max_repeaters; ++i) {
-            address = Address::parse(Address::Type::Repeater, bytes, offset);
+        while (repeater_count < max_repeaters) {
+            address = Address::parse(Address::Type::Repeater, bytes, size, offset);
             if (!address.has_value()) {
                 logger.warning() << "Invalid address block";
                 return {};
             }
 
             offset += Address::address_block_size;
-            repeaters.push_back(address.value());
+            repeaters[repeater_count++] = address.value();
             if (address->is_end_byte())
                 break;
         }
@@ -181,105 +203,114 @@ std::optional<Packet> Packet::parse(const std::vector<u8>& bytes) {
     Type type = (control % 2) ? (control & 2) ? Type::Unnumbered : Type::Supervisory : Type::Information;
 
     bool poll = control & poll_mask;
-    //FIXME: The FCS byte is currently just appended to the data, we should check it
-    //NOTE: APRS seems to not use the FCS, is there a way to detect if it is included?
     //FIXME: mod 128 support not implemented
 
     if (type == Type::Information) {
-        u8 pid = bytes[offset++];
-        if (pid == pid_escape)
-            pid = bytes[offset++];
-
-        Buffer<u8> data(bytes.size() - offset);
-        std::memcpy(data.ptr(), bytes.data() + offset, data.size());
+        auto pid = read_pid(bytes, size, offset);
+        if (!pid.has_value()) {
+            logger.warning() << "Packet has no PID";
+            return {};
+        }
 
         InformationData information;
-        information.pid = pid_by_byte(pid);
+        information.pid = pid_by_byte(*pid);
         information.receive_sequence_number = control >> 1 & 0x07;
         information.send_sequence_number = control >> 5 & 0x07;
 
-        return Packet(type, source, destination, std::move(repeaters), control, poll, std::move(data), PacketContents { .information = information });
+        return PacketView(type, source, destination, repeaters, repeater_count, control, poll, data_field(bytes, size, offset), PacketContents { .information = information });
     } else if (type == Type::Supervisory) {
         SupervisoryData supervisory;
         supervisory.receive_type = receive_type_by_byte(control >> 2 & 0x3);
         supervisory.receive_sequence_number = control << 5 & 0x7;
 
-        return Packet(type, source, destination, std::move(repeaters), control, poll, {}, PacketContents { .supervisory = supervisory });
+        return PacketView(type, source, destination, repeaters, repeater_count, control, poll, {}, PacketContents { .supervisory = supervisory });
     } else if (type == Type::Unnumbered) {
         UnnumberedData unnumbered;
         u8 control_type = control >> 2;
         control_type = (control_type & 0x34) >> 1 | (control_type & 0x3);
         if (!control_type) { // Unnumbered information
-            u8 pid = bytes[offset++];
-            if (pid == pid_escape)
-                pid = bytes[offset++];
-            unnumbered.pid = pid_by_byte(pid);
+            auto pid = read_pid(bytes, size, offset);
+            if (!pid.has_value()) {
+                logger.warning() << "Packet has no PID";
+                return {};
+            }
+
+            unnumbered.pid = pid_by_byte(*pid);
         } else {
             unnumbered.pid = "Packet has no PID";
         }
         unnumbered.control_type = control_type_by_byte(control_type);
 
-        Buffer<u8> data;
-        if (uses_information(control_type)) {
-            data = Buffer<u8>(bytes.size() - offset);
-            std::memcpy(data.ptr(), bytes.data() + offset, data.size());
-        }
+        std::string_view data;
+        if (uses_information(control_type))
+            data = data_field(bytes, size, offset);
 
-        return Packet(type, source, destination, std::move(repeaters), control, poll, data, PacketContents { .unnumbered = unnumbered });
+        return PacketView(type, source, destination, repeaters, repeater_count, control, poll, data, PacketContents { .unnumbered = unnumbered });
     }
 
     assert(false);
     return {};
 }
 
-std::string Packet::format() const {
-    std::ostringstream builder;
+size_t PacketView::format(char* buffer, size_t size) const {
+    Util::FixedStringBuilder builder(buffer, size);
     auto time = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
 
-    builder << "Received at " << std::ctime(&time);
-    builder << "Type: ";
+    builder.append("Received at ");
+    builder.append(std::ctime(&time));
+    builder.append("Type: ");
     switch (m_type) {
     case Type::Information:
-        builder << "Information\n";
-        builder << "Pid: " << m_contents.information.pid
-                << ", SSN: " << std::hex << "0x" << static_cast<unsigned>(m_contents.information.send_sequence_number)
-                << ", RSN: " << static_cast<unsigned>(m_contents.information.receive_sequence_number);
+        builder.append("Information\n");
+        builder.appendf("Pid: %s, SSN: 0x%x, RSN: %x",
+                        m_contents.information.pid,
+                        static_cast<unsigned>(m_contents.information.send_sequence_number),
+                        static_cast<unsigned>(m_contents.information.receive_sequence_number));
         break;
     case Type::Supervisory:
-        builder << "Supervisory\n";
-        builder << "Receive type: " << m_contents.supervisory.receive_type
-                << ", RSN: " << std::hex << "0x" << static_cast<unsigned>(m_contents.supervisory.receive_sequence_number);
+        builder.append("Supervisory\n");
+        builder.appendf("Receive type: %s, RSN: 0x%x",
+                        m_contents.supervisory.receive_type,
+                        static_cast<unsigned>(m_contents.supervisory.receive_sequence_number));
         break;
     case Type::Unnumbered:
-        builder << "Unnumbered\n";
-        builder << m_contents.unnumbered.control_type
-                << ", Pid: " << m_contents.unnumbered.pid;
+        builder.append("Unnumbered\n");
+        builder.appendf("%s, Pid: %s", m_contents.unnumbered.control_type, m_contents.unnumbered.pid);
         break;
     default:
         assert(false);
     }
 
-    builder << " (0x" << std::hex << static_cast<unsigned>(m_control) << ")";
+    builder.appendf(" (0x%x)", static_cast<unsigned>(m_control));
 
     if (is_poll())
-        builder << " [Poll]";
-    builder << '\n'
-            << m_source.format() << "->";
-
-    for (auto& repeater : m_repeaters)
-        builder << '\n'
-                << repeater.format() << "->";
+        builder.append(" [Poll]");
+    builder.append('\n');
+    m_source.format(builder);
+    builder.append("->");
+
+    for (u8 i = 0; i < m_repeater_count; ++i) {
+        builder.append('\n');
+        m_repeaters[i].format(builder);
+        builder.append("->");
+    }
 
-    builder << '\n'
-            << m_destination.format() << '\n';
+    builder.append('\n');
+    m_destination.format(builder);
+    builder.append('\n');
 
-    builder << ">>>\n";
+    builder.append(">>>\n");
     if (m_data.size()) {
-        for (u8 byte : m_data)
-            builder << Util::escape_ascii(byte);
+        for (char c : m_data) {
+            const char* escape_sequence = Util::ascii_escape_sequence(c);
+            if (escape_sequence)
+                builder.append(escape_sequence);
+            else
+                builder.append(static_cast<char>(c & 0x7F));
+        }
     } else {
-        builder << "[Packet has no data field]";
+        builder.append("[Packet has no data field]");
     }
-    builder << "\n<<<\n\n";
-    return builder.str();
+    builder.append("\n<<<\n\n");
+    return builder.length();
 }
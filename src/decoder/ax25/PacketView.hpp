@@ -28,15 +28,18 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #pragma once
 
 #include "Address.hpp"
+#include <array>
 #include <optional>
-#include <string>
-#include <util/Buffer.hpp>
+#include <string_view>
 #include <util/Types.hpp>
-#include <vector>
 
 namespace Dsp::AX25Protocol {
 
-class Packet {
+/*
+ * A parsed frame, which refers to the data field in the frame bytes instead of copying it. It has to be used
+ * before the bytes it was parsed from are overwritten.
+ */
+class PacketView {
 public:
     /*
          * https://www.tapr.org/pub_ax25.html
@@ -155,7 +158,8 @@ public:
     static constexpr u8 poll_mask { 0x10 };
     static constexpr u8 max_repeaters { 8 };
     static constexpr u8 min_packet_size { 15 }; //120 bits
-    static constexpr u8 pid_escape { 0xFF };    //120 bits
+    static constexpr u8 pid_escape { 0xFF };
+    static constexpr u8 fcs_size { 2 };
 
     struct InformationData {
         const char* pid;
@@ -179,10 +183,17 @@ public:
         UnnumberedData unnumbered;
     } PacketContents;
 
-    static std::optional<Packet> parse(const std::vector<u8>& bytes);
+    /* Expects the bytes between the flags, with the FCS already checked and removed */
+    static std::optional<PacketView> parse(const u8* bytes, size_t size);
 
-    std::string format() const;
+    /* Writes the packet as text into the buffer, truncating it if needed. Returns the length of the text */
+    size_t format(char* buffer, size_t size) const;
     bool is_poll() const { return m_poll; }
+    const Address& source() const { return m_source; }
+    const Address& destination() const { return m_destination; }
+    u8 repeater_count() const { return m_repeater_count; }
+    const Address& repeater(u8 index) const { return m_repeaters[index]; }
+    std::string_view data() const { return m_data; }
 
 private:
     enum class Type : u8 {
@@ -191,20 +202,23 @@ private:
         Unnumbered
     };
 
-    Packet(Type, Address, Address, std::vector<Address>, u8, bool, Buffer<u8>, PacketContents);
+    PacketView(Type, Address, Address, const std::array<Address, max_repeaters>&, u8, u8, bool, std::string_view, PacketContents);
 
     static const char* pid_by_byte(u8);
     static const char* control_type_by_byte(u8);
     static const char* receive_type_by_byte(u8);
     static bool uses_information(u8);
+    static std::optional<u8> read_pid(const u8* bytes, size_t size, size_t& offset);
+    static std::string_view data_field(const u8* bytes, size_t size, size_t offset);
 
     Type m_type;
     Address m_source;
     Address m_destination;
-    std::vector<Address> m_repeaters;
+    std::array<Address, max_repeaters> m_repeaters;
+    u8 m_repeater_count;
     u8 m_control;
     bool m_poll;
-    Buffer<u8> m_data;
+    std::string_view m_data;
     PacketContents m_contents;
 };
 
@@ -71,101 +71,6 @@ void Dcf77::on_setup() {
     set_status(info_for_state(m_state).description);
 }
 
-Fl_Widget* Dcf77::build_ui(Point top_left, Size ui_size) {
-    auto* root = new Fl_Group(top_left.x(), top_left.y(), ui_size.w(), ui_size.h());
-    m_date_label = new Fl_Box(top_left.x(), top_left.y(), ui_size.w(), 40, "---, --.--.----");
-    m_date_label->labelsize(35);
-    m_date_label->labelfont(FL_BOLD);
-
-    m_time_label = new Fl_Box(top_left.x(), m_date_label->y() + m_date_label->h() + 4, ui_size.w(), 120, "--:--:--");
-    m_time_label->labelsize(100);
-    m_time_label->labelfont(FL_BOLD);
-
-    u16 indicator_offset_y = m_time_label->y() + m_time_label->h();
-    auto* indicators = new Fl_Group(top_left.x(), indicator_offset_y, ui_size.w(), ui_size.h() - (indicator_offset_y - top_left.y()));
-    Point indicator_pos(top_left.x() + 4, indicator_offset_y + 4);
-    u16 indicator_height = indicators->h() - 8;
-    constexpr u8 indicator_width = 72;
-    constexpr u8 indicator_spacing = 4;
-
-    m_rx_indicator = new Ui::Indicator(indicator_pos.x(),
-                                       indicator_pos.y(),
-                                       indicator_width,
-                                       indicator_height,
-                                       Ui::Indicator::green_on,
-                                       Ui::Indicator::green_off,
-                                       "Receiving");
-
-    indicator_pos.translate(indicator_width + indicator_spacing, 0);
-    m_rx_fail_indicator = new Ui::Indicator(indicator_pos.x(),
-                                            indicator_pos.y(),
-                                            indicator_width,
-                                            indicator_height,
-                                            Ui::Indicator::red_on,
-                                            Ui::Indicator::red_off,
-                                            "\nReceive\nfailed");
-
-    indicator_pos.translate(indicator_width + indicator_spacing, 0);
-    m_cet_indicator = new Ui::Indicator(indicator_pos.x(),
-                                        indicator_pos.y(),
-                                        indicator_width,
-                                        indicator_height,
-                                        Ui::Indicator::green_on,
-                                        Ui::Indicator::green_off,
-                                        "\nCET\n(+1 UTC)");
-
-    indicator_pos.translate(indicator_width + indicator_spacing, 0);
-    m_cest_indicator = new Ui::Indicator(indicator_pos.x(),
-                                         indicator_pos.y(),
-                                         indicator_width, indicator_height,
-                                         Ui::Indicator::green_on,
-                                         Ui::Indicator::green_off,
-                                         "\nCEST\n(+2 UTC)");
-
-    indicator_pos = Point(top_left.x() + ui_size.w() - indicator_width - 4, indicator_pos.y());
-    m_minute_parity_indicator = new Ui::Indicator(indicator_pos.x(),
-                                                  indicator_pos.y(),
-                                                  indicator_width,
-                                                  indicator_height,
-                                                  Ui::Indicator::red_on,
-                                                  Ui::Indicator::red_off,
-                                                  "\nMinute\nparity");
-
-    indicator_pos.translate(-indicator_width - indicator_spacing, 0);
-    m_hour_parity_indicator = new Ui::Indicator(indicator_pos.x(),
-                                                indicator_pos.y(),
-                                                indicator_width,
-                                                indicator_height,
-                                                Ui::Indicator::red_on,
-                                                Ui::Indicator::red_off,
-                                                "\nHour\nparity");
-
-    indicator_pos.translate(-indicator_width - indicator_spacing, 0);
-    m_date_parity_indicator = new Ui::Indicator(indicator_pos.x(),
-                                                indicator_pos.y(),
-                                                indicator_width,
-                                                indicator_height,
-                                                Ui::Indicator::red_on,
-                                                Ui::Indicator::red_off,
-                                                "\nDate\nparity");
-
-    indicator_pos.translate(-indicator_width - indicator_spacing, 0);
-    m_call_indicator = new Ui::Indicator(indicator_pos.x(),
-                                         indicator_pos.y(),
-                                         indicator_width,
-                                         indicator_height,
-                                         Ui::Indicator::red_on,
-                                         Ui::Indicator::red_off,
-                                         "\nAbnormal\nTX operation");
-
-    auto* spring = new Fl_Box(m_call_indicator->x() - 5, m_call_indicator->y(), 1, 1);
-    indicators->resizable(spring);
-    indicators->end();
-    root->resizable(indicators);
-    root->end();
-    return root;
-}
-
 void Dcf77::on_marker_move(Hertz center_frequency) {
     m_mixer->set_frequency(center_frequency);
 }
@@ -212,7 +117,7 @@ void Dcf77::process_pipeline_result(bool sample) {
                     m_seconds = -1;
                     m_time = m_receiving;
                     m_receiving = {};
-                    update_minute();
+                    show_minute();
                     m_tick = true;
                     logger().info() << "Detected minute marker";
                 }
@@ -227,8 +132,7 @@ void Dcf77::process_pipeline_result(bool sample) {
                         logger().info() << "Invalid bit received!";
                         m_state = State::WaitForMinuteMarker;
                         m_receiving = {};
-                        if (Drtd::using_ui())
-                            m_rx_fail_indicator->set_state(true);
+                        show_receive_failed(true);
                     }
 
                     if (state_info.point_of_read == m_bits_received) {
@@ -237,8 +141,7 @@ void Dcf77::process_pipeline_result(bool sample) {
                             logger().info() << "Did not receive expected marker bit!";
                             m_state = State::WaitForMinuteMarker;
                             m_receiving = {};
-                            if (Drtd::using_ui())
-                                m_rx_fail_indicator->set_state(true);
+                            show_receive_failed(true);
                         } else {
                             switch (m_state) {
                             case State::ReadStatus:
@@ -288,14 +191,11 @@ void Dcf77::process_pipeline_result(bool sample) {
                     ++m_bits_received;
                     if (m_bits_received == 59) {
                         logger().info() << "Successfully received!";
-                        if (Drtd::using_ui())
-                            m_rx_fail_indicator->set_state(false);
-
+                        show_receive_failed(false);
                         m_state = State::WaitForMinuteMarker;
                     }
 
-                    if (Drtd::using_ui())
-                        m_rx_indicator->set_state(m_state != State::WaitForMinuteMarker);
+                    show_receiving(m_state != State::WaitForMinuteMarker);
                 }
             }
 
@@ -317,22 +217,25 @@ void Dcf77::process_pipeline_result(bool sample) {
     }
 
     ++m_level_count;
-    if ((tick_time() || new_second) && !Drtd::using_ui()) {
-        const bool time_valid = (m_time.cest && !m_time.cet) || (!m_time.cest && m_time.cet);
-        std::ostringstream builder;
+    if (tick_time() || new_second)
+        print_time();
+}
 
-        builder << create_date_string() << " - " << create_time_string() << " ; ";
-        if (!time_valid || m_time.date_parity_error || m_time.hour_parity_error || m_time.minute_parity_error)
-            builder << 'E';
+void Dcf77::print_time() {
+    const bool time_valid = (m_time.cest && !m_time.cet) || (!m_time.cest && m_time.cet);
+    std::ostringstream builder;
 
-        if (m_time.cet)
-            builder << " CET";
+    builder << create_date_string() << " - " << create_time_string() << " ; ";
+    if (!time_valid || m_time.date_parity_error || m_time.hour_parity_error || m_time.minute_parity_error)
+        builder << 'E';
 
-        if (m_time.cest)
-            builder << " CEST";
+    if (m_time.cet)
+        builder << " CET";
 
-        puts(builder.str().c_str());
-    }
+    if (m_time.cest)
+        builder << " CEST";
+
+    puts(builder.str().c_str());
 }
 
 bool Dcf77::tick_time() {
@@ -357,27 +260,13 @@ void Dcf77::advance_time() {
     ++m_seconds;
     m_seconds %= 60;
 
-    if (Drtd::using_ui())
-        m_time_label->copy_label(create_time_string().c_str());
+    show_time();
 }
 
 Dcf77::State Dcf77::next_state(Dcf77::State state) {
     return static_cast<State>((static_cast<u8>(state) + 1) % static_cast<u8>(State::__Count));
 }
 
-void Dcf77::update_minute() {
-    if (!Drtd::using_ui())
-        return;
-
-    m_date_label->copy_label(create_date_string().c_str());
-    m_minute_parity_indicator->set_state(m_time.minute_parity_error);
-    m_hour_parity_indicator->set_state(m_time.hour_parity_error);
-    m_date_parity_indicator->set_state(m_time.date_parity_error);
-    m_cest_indicator->set_state(m_time.cest);
-    m_cet_indicator->set_state(m_time.cet);
-    m_call_indicator->set_state(m_time.call);
-}
-
 std::string Dcf77::create_time_string() const {
     std::ostringstream builder;
     builder.fill('0');
@@ -30,41 +30,15 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <chrono>
 #include <decoder/Decoder.hpp>
 #include <dsp/IQMixer.hpp>
-#include <ui/component/Indicator.hpp>
 #include <util/SNRCalculator.hpp>
 
 namespace Dsp {
 
-class Dcf77 final : public Decoder<bool> {
+class Dcf77 : public Decoder<bool> {
 public:
     Dcf77();
 
 protected:
-    virtual Pipe::Line<float, bool> build_pipeline() override;
-    virtual Fl_Widget* build_ui(Point, Size) override;
-    virtual void process_pipeline_result(bool) override;
-    virtual void on_marker_move(Hertz) override;
-    virtual void on_setup() override;
-    virtual Util::Buffer<std::string> changeable_parameters() const override;
-    virtual bool setup_parameters(const Util::Buffer<std::string>&) override;
-
-private:
-    enum class State : u8 {
-        WaitForMinuteMarker,
-        ReadStartOfMinute,
-        ReadCivilWarning,
-        ReadStatus,
-        ReadStartOfTime,
-        ReadMinutes,
-        ReadHours,
-        ReadDayOfMonth,
-        ReadDayOfWeek,
-        ReadMonthNumber,
-        ReadYear,
-        ReadDateParity,
-        __Count
-    };
-
     struct TimeInfo {
         TimeInfo()
             : call(false)
@@ -89,6 +63,40 @@ private:
         bool date_parity_error : 1;
     };
 
+    virtual Pipe::Line<float, bool> build_pipeline() override;
+    virtual void process_pipeline_result(bool) override;
+    virtual void on_marker_move(Hertz) override;
+    virtual void on_setup() override;
+    virtual Util::Buffer<std::string> changeable_parameters() const override;
+    virtual bool setup_parameters(const Util::Buffer<std::string>&) override;
+    /* Without a UI, the time is printed every second */
+    virtual void print_time();
+    virtual void show_time() {}
+    virtual void show_minute() {}
+    virtual void show_receiving(bool) {}
+    virtual void show_receive_failed(bool) {}
+    std::string create_date_string() const;
+    std::string create_time_string() const;
+
+    TimeInfo m_time;
+
+private:
+    enum class State : u8 {
+        WaitForMinuteMarker,
+        ReadStartOfMinute,
+        ReadCivilWarning,
+        ReadStatus,
+        ReadStartOfTime,
+        ReadMinutes,
+        ReadHours,
+        ReadDayOfMonth,
+        ReadDayOfWeek,
+        ReadMonthNumber,
+        ReadYear,
+        ReadDateParity,
+        __Count
+    };
+
     struct StateInfo {
         u8 point_of_read;
         std::string description;
@@ -98,15 +106,11 @@ private:
     static StateInfo info_for_state(State);
     static State next_state(State);
     bool tick_time();
-    void update_minute();
     void advance_time();
-    std::string create_date_string() const;
-    std::string create_time_string() const;
 
     ConfigRef<IQMixer> m_mixer;
     Util::SNRCalculator m_snr_calculator;
     State m_state { State::WaitForMinuteMarker };
-    TimeInfo m_time;
     TimeInfo m_receiving;
     bool m_last_level { false };
     bool m_parity;
@@ -117,16 +121,6 @@ private:
     u32 m_bits { 0 };
     u32 m_ticks { 0 };
     i8 m_seconds { 0 };
-    Fl_Box* m_time_label { nullptr };
-    Fl_Box* m_date_label { nullptr };
-    Ui::Indicator* m_minute_parity_indicator { nullptr };
-    Ui::Indicator* m_hour_parity_indicator { nullptr };
-    Ui::Indicator* m_date_parity_indicator { nullptr };
-    Ui::Indicator* m_cest_indicator { nullptr };
-    Ui::Indicator* m_cet_indicator { nullptr };
-    Ui::Indicator* m_call_indicator { nullptr };
-    Ui::Indicator* m_rx_indicator { nullptr };
-    Ui::Indicator* m_rx_fail_indicator { nullptr };
 };
 
 }
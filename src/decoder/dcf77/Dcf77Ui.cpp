@@ -0,0 +1,148 @@
+/*
+BSD 2-Clause License
+
+Copyright (c) 2020, Till Mayer
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "Dcf77Ui.hpp"
+#include <FL/Fl_Group.H>
+
+using namespace Dsp;
+
+Fl_Widget* Dcf77Ui::build_ui(Point top_left, Size ui_size) {
+    auto* root = new Fl_Group(top_left.x(), top_left.y(), ui_size.w(), ui_size.h());
+    m_date_label = new Fl_Box(top_left.x(), top_left.y(), ui_size.w(), 40, "---, --.--.----");
+    m_date_label->labelsize(35);
+    m_date_label->labelfont(FL_BOLD);
+
+    m_time_label = new Fl_Box(top_left.x(), m_date_label->y() + m_date_label->h() + 4, ui_size.w(), 120, "--:--:--");
+    m_time_label->labelsize(100);
+    m_time_label->labelfont(FL_BOLD);
+
+    u16 indicator_offset_y = m_time_label->y() + m_time_label->h();
+    auto* indicators = new Fl_Group(top_left.x(), indicator_offset_y, ui_size.w(), ui_size.h() - (indicator_offset_y - top_left.y()));
+    Point indicator_pos(top_left.x() + 4, indicator_offset_y + 4);
+    u16 indicator_height = indicators->h() - 8;
+    constexpr u8 indicator_width = 72;
+    constexpr u8 indicator_spacing = 4;
+
+    m_rx_indicator = new Ui::Indicator(indicator_pos.x(),
+                                       indicator_pos.y(),
+                                       indicator_width,
+                                       indicator_height,
+                                       Ui::Indicator::green_on,
+                                       Ui::Indicator::green_off,
+                                       "Receiving");
+
+    indicator_pos.translate(indicator_width + indicator_spacing, 0);
+    m_rx_fail_indicator = new Ui::Indicator(indicator_pos.x(),
+                                            indicator_pos.y(),
+                                            indicator_width,
+                                            indicator_height,
+                                            Ui::Indicator::red_on,
+                                            Ui::Indicator::red_off,
+                                            "\nReceive\nfailed");
+
+    indicator_pos.translate(indicator_width + indicator_spacing, 0);
+    m_cet_indicator = new Ui::Indicator(indicator_pos.x(),
+                                        indicator_pos.y(),
+                                        indicator_width,
+                                        indicator_height,
+                                        Ui::Indicator::green_on,
+                                        Ui::Indicator::green_off,
+                                        "\nCET\n(+1 UTC)");
+
+    indicator_pos.translate(indicator_width + indicator_spacing, 0);
+    m_cest_indicator = new Ui::Indicator(indicator_pos.x(),
+                                         indicator_pos.y(),
+                                         indicator_width, indicator_height,
+                                         Ui::Indicator::green_on,
+                                         Ui::Indicator::green_off,
+                                         "\nCEST\n(+2 UTC)");
+
+    indicator_pos = Point(top_left.x() + ui_size.w() - indicator_width - 4, indicator_pos.y());
+    m_minute_parity_indicator = new Ui::Indicator(indicator_pos.x(),
+                                                  indicator_pos.y(),
+                                                  indicator_width,
+                                                  indicator_height,
+                                                  Ui::Indicator::red_on,
+                                                  Ui::Indicator::red_off,
+                                                  "\nMinute\nparity");
+
+    indicator_pos.translate(-indicator_width - indicator_spacing, 0);
+    m_hour_parity_indicator = new Ui::Indicator(indicator_pos.x(),
+                                                indicator_pos.y(),
+                                                indicator_width,
+                                                indicator_height,
+                                                Ui::Indicator::red_on,
+                                                Ui::Indicator::red_off,
+                                                "\nHour\nparity");
+
+    indicator_pos.translate(-indicator_width - indicator_spacing, 0);
+    m_date_parity_indicator = new Ui::Indicator(indicator_pos.x(),
+                                                indicator_pos.y(),
+                                                indicator_width,
+                                                indicator_height,
+                                                Ui::Indicator::red_on,
+                                                Ui::Indicator::red_off,
+                                                "\nDate\nparity");
+
+    indicator_pos.translate(-indicator_width - indicator_spacing, 0);
+    m_call_indicator = new Ui::Indicator(indicator_pos.x(),
+                                         indicator_pos.y(),
+                                         indicator_width,
+                                         indicator_height,
+                                         Ui::Indicator::red_on,
+                                         Ui::Indicator::red_off,
+                                         "\nAbnormal\nTX operation");
+
+    auto* spring = new Fl_Box(m_call_indicator->x() - 5, m_call_indicator->y(), 1, 1);
+    indicators->resizable(spring);
+    indicators->end();
+    root->resizable(indicators);
+    root->end();
+    return root;
+}
+
+void Dcf77Ui::show_time() {
+    m_time_label->copy_label(create_time_string().c_str());
+}
+
+void Dcf77Ui::show_minute() {
+    m_date_label->copy_label(create_date_string().c_str());
+    m_minute_parity_indicator->set_state(m_time.minute_parity_error);
+    m_hour_parity_indicator->set_state(m_time.hour_parity_error);
+    m_date_parity_indicator->set_state(m_time.date_parity_error);
+    m_cest_indicator->set_state(m_time.cest);
+    m_cet_indicator->set_state(m_time.cet);
+    m_call_indicator->set_state(m_time.call);
+}
+
+void Dcf77Ui::show_receiving(bool receiving) {
+    m_rx_indicator->set_state(receiving);
+}
+
+void Dcf77Ui::show_receive_failed(bool failed) {
+    m_rx_fail_indicator->set_state(failed);
+}
@@ -0,0 +1,60 @@
+/*
+BSD 2-Clause License
+
+Copyright (c) 2020, Till Mayer
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#pragma once
+
+#include "Dcf77.hpp"
+#include <FL/Fl_Box.H>
+#include <ui/component/Indicator.hpp>
+
+namespace Dsp {
+
+class Dcf77Ui final : public Dcf77 {
+public:
+    virtual Fl_Widget* build_ui(Point, Size) override;
+
+protected:
+    virtual void print_time() override {}
+    virtual void show_time() override;
+    virtual void show_minute() override;
+    virtual void show_receiving(bool) override;
+    virtual void show_receive_failed(bool) override;
+
+private:
+    Fl_Box* m_time_label { nullptr };
+    Fl_Box* m_date_label { nullptr };
+    Ui::Indicator* m_minute_parity_indicator { nullptr };
+    Ui::Indicator* m_hour_parity_indicator { nullptr };
+    Ui::Indicator* m_date_parity_indicator { nullptr };
+    Ui::Indicator* m_cest_indicator { nullptr };
+    Ui::Indicator* m_cet_indicator { nullptr };
+    Ui::Indicator* m_call_indicator { nullptr };
+    Ui::Indicator* m_rx_indicator { nullptr };
+    Ui::Indicator* m_rx_fail_indicator { nullptr };
+};
+
+}
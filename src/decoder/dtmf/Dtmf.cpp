@@ -26,7 +26,6 @@ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 #include "Dtmf.hpp"
-#include <FL/Fl_Button.H>
 #include <dsp/GoertzelFilter.hpp>
 #include <dsp/Mapper.hpp>
 #include <pipe/Parallel.hpp>
@@ -80,41 +79,6 @@ static Pipe::Parallel<float, float, u8> column_filter_bank() {
                           GoertzelFilter(filter_taps, 941));
 }
 
-Fl_Widget* Dtmf::build_ui(Point top_left, Size ui_size) {
-    m_callback_manager.forget_callbacks();
-    auto* root = new Fl_Group(top_left.x(), top_left.y(), ui_size.w(), ui_size.h());
-
-    auto* controls = new Fl_Group(top_left.x(), top_left.y(), ui_size.w(), 44);
-    controls->box(FL_EMBOSSED_BOX);
-
-    auto control_offset = top_left.translated(4, 4);
-    Size control_size(ui_size.w() - 8, controls->h() - 8);
-
-    m_detect_indicator = new Ui::Indicator(control_offset.x() + 10,
-                                           control_offset.y(),
-                                           40,
-                                           control_size.h(),
-                                           Ui::Indicator::green_on,
-                                           Ui::Indicator::green_off,
-                                           "Detected");
-
-    auto* clear_button = new Fl_Button(controls->x() + controls->w() - 54, controls->y() + 4, 50, controls->h() - 8, "Clear");
-    m_callback_manager.register_callback(*clear_button, [&]() { m_text_box->clear(); });
-
-    auto* spring = new Fl_Box(clear_button->x(), clear_button->y(), 0, 0);
-    controls->resizable(spring);
-    controls->end();
-
-    top_left.translate(0, controls->h() + 2);
-    ui_size.resize(0, -controls->h() - 2);
-
-    m_text_box = new Ui::TextDisplay(top_left.x(), top_left.y(), ui_size.w(), ui_size.h());
-    m_text_box->textfont(FL_COURIER);
-    root->resizable(m_text_box);
-    root->end();
-    return root;
-}
-
 void Dtmf::process_pipeline_result(u8 sample) {
     const u8 row = sample % 10;
     const u8 column = sample / 10;
@@ -134,14 +98,7 @@ void Dtmf::process_pipeline_result(u8 sample) {
             m_sample_count = 1;
             m_samples_since_last_valid_symbol = 1;
 
-            if (Drtd::using_ui()) {
-                const char buf[] { decoded, 0 };
-                m_text_box->buffer()->append(buf);
-                m_detect_indicator->set_state(true);
-            } else {
-                printf("%c", decoded);
-                fflush(stdout);
-            }
+            show_symbol(decoded);
         } else {
             m_last_interruption_length += m_sample_count;
         }
@@ -153,15 +110,7 @@ void Dtmf::process_pipeline_result(u8 sample) {
     }
 
     if (m_samples_since_last_valid_symbol > minimum_samples_per_block && m_samples_since_last_valid_symbol) {
-        if (Drtd::using_ui()) {
-            const bool scroll = m_text_box->should_autoscroll();
-            m_text_box->buffer()->append("\n");
-            if (scroll)
-                m_text_box->scroll_to_bottom();
-            m_detect_indicator->set_state(false);
-        } else {
-            printf("\n");
-        }
+        end_block();
 
         m_samples_since_last_valid_symbol = 0;
     } else if (m_samples_since_last_valid_symbol) {
@@ -169,6 +118,15 @@ void Dtmf::process_pipeline_result(u8 sample) {
     }
 }
 
+void Dtmf::show_symbol(char symbol) {
+    printf("%c", symbol);
+    fflush(stdout);
+}
+
+void Dtmf::end_block() {
+    printf("\n");
+}
+
 Pipe::Line<float, u8> Dtmf::build_pipeline() {
     std::function<u8(const Buffer<u8>&)> func = [](const Buffer<u8>& in) { return in[0] + in[1] * 10; };
     return Pipe::line(Pipe::parallel(func, column_filter_bank(), row_filter_bank()));
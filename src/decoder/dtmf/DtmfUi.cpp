@@ -0,0 +1,79 @@
+/*
+BSD 2-Clause License
+
+Copyright (c) 2020, Till Mayer
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "DtmfUi.hpp"
+#include <FL/Fl_Box.H>
+#include <FL/Fl_Button.H>
+#include <FL/Fl_Group.H>
+
+using namespace Dsp;
+
+Fl_Widget* DtmfUi::build_ui(Point top_left, Size ui_size) {
+    m_callback_manager.forget_callbacks();
+    auto* root = new Fl_Group(top_left.x(), top_left.y(), ui_size.w(), ui_size.h());
+
+    auto* controls = new Fl_Group(top_left.x(), top_left.y(), ui_size.w(), 44);
+    controls->box(FL_EMBOSSED_BOX);
+
+    auto control_offset = top_left.translated(4, 4);
+    Size control_size(ui_size.w() - 8, controls->h() - 8);
+
+    m_detect_indicator = new Ui::Indicator(control_offset.x() + 10,
+                                           control_offset.y(),
+                                           40,
+                                           control_size.h(),
+                                           Ui::Indicator::green_on,
+                                           Ui::Indicator::green_off,
+                                           "Detected");
+
+    auto* clear_button = new Fl_Button(controls->x() + controls->w() - 54, controls->y() + 4, 50, controls->h() - 8, "Clear");
+    m_callback_manager.register_callback(*clear_button, [&]() { m_text_box->clear(); });
+
+    auto* spring = new Fl_Box(clear_button->x(), clear_button->y(), 0, 0);
+    controls->resizable(spring);
+    controls->end();
+
+    top_left.translate(0, controls->h() + 2);
+    ui_size.resize(0, -controls->h() - 2);
+
+    m_text_box = new Ui::TextDisplay(top_left.x(), top_left.y(), ui_size.w(), ui_size.h());
+    m_text_box->textfont(FL_COURIER);
+    root->resizable(m_text_box);
+    root->end();
+    return root;
+}
+
+void DtmfUi::show_symbol(char symbol) {
+    const char buf[] { symbol, 0 };
+    m_text_box->append(buf);
+    m_detect_indicator->set_state(true);
+}
+
+void DtmfUi::end_block() {
+    m_text_box->append("\n");
+    m_detect_indicator->set_state(false);
+}
@@ -30,12 +30,11 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 namespace Dsp {
 
-class Null final : public Decoder<float> {
+class Null : public Decoder<float> {
 public:
     Null();
 
 protected:
-    virtual Fl_Widget* build_ui(Point top_left, Size ui_size) override;
     virtual Pipe::Line<float, float> build_pipeline() override;
     virtual void process_pipeline_result(float) override {};
 };
@@ -0,0 +1,100 @@
+/*
+BSD 2-Clause License
+
+Copyright (c) 2020, Till Mayer
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "AddressFilter.hpp"
+#include <cstdlib>
+#include <fstream>
+
+using namespace Dsp::PocsagProtocol;
+
+static std::optional<u32> parse_address(const std::string& text) {
+    if (text.empty())
+        return {};
+
+    char* last = nullptr;
+    const auto address = std::strtoul(text.c_str(), &last, 10);
+    if (*last != '\0' || address >= AddressFilter::address_count)
+        return {};
+
+    return static_cast<u32>(address);
+}
+
+AddressFilter::AddressFilter()
+    : m_allowed(address_count, false)
+    , m_denied(address_count, false) {
+}
+
+std::optional<AddressFilter> AddressFilter::load(const std::string& path) {
+    std::ifstream file(path);
+    if (!file.good()) {
+        s_log.error() << "Could not open \"" << path << '"';
+        return {};
+    }
+
+    AddressFilter filter;
+    std::string line;
+    for (size_t line_number = 1; std::getline(file, line); ++line_number) {
+        if (!filter.parse_line(line)) {
+            s_log.error() << "Invalid entry in line " << line_number << ": \"" << line << '"';
+            return {};
+        }
+    }
+
+    s_log.info() << "Loaded \"" << path << '"';
+    return filter;
+}
+
+bool AddressFilter::parse_line(const std::string& line) {
+    const auto first = line.find_first_not_of(" \t\r");
+    if (first == std::string::npos || line[first] == '#')
+        return true;
+
+    auto entry = line.substr(first, line.find_last_not_of(" \t\r") - first + 1);
+    const bool deny = entry[0] == '!';
+    if (deny)
+        entry.erase(0, 1);
+
+    std::optional<u32> from;
+    std::optional<u32> to;
+    const auto separator = entry.find('-');
+    if (separator == std::string::npos) {
+        from = to = parse_address(entry);
+    } else {
+        from = parse_address(entry.substr(0, separator));
+        to = parse_address(entry.substr(separator + 1));
+    }
+
+    if (!from.has_value() || !to.has_value() || from.value() > to.value())
+        return false;
+
+    auto& set = deny ? m_denied : m_allowed;
+    for (u32 address = from.value(); address <= to.value(); ++address)
+        set[address] = true;
+
+    m_has_allowed |= !deny;
+    return true;
+}
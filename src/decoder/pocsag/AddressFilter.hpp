@@ -0,0 +1,70 @@
+/*
+BSD 2-Clause License
+
+Copyright (c) 2020, Till Mayer
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#pragma once
+
+#include <optional>
+#include <string>
+#include <util/Logger.hpp>
+#include <util/Types.hpp>
+#include <vector>
+
+namespace Dsp::PocsagProtocol {
+
+/*
+ * Decides which addresses (capcodes) are shown. Every line of a filter file holds a single address or
+ * a range like "1000-1999", prefixed with '!' to deny instead of allow. Lines starting with '#' are
+ * ignored. Without any allowing entry, everything not explicitly denied is shown.
+ */
+class AddressFilter final {
+public:
+    static constexpr u8 address_bit_count { 21 };
+    static constexpr u32 address_count { static_cast<u32>(1) << address_bit_count };
+
+    static std::optional<AddressFilter> load(const std::string& path);
+
+    bool accepts(u32 address) const {
+        if (address >= address_count)
+            return false;
+
+        return !m_denied[address] && (!m_has_allowed || m_allowed[address]);
+    }
+
+private:
+    AddressFilter();
+
+    bool parse_line(const std::string&);
+
+    static inline Logger s_log { "Address filter" };
+
+    /* One bit per possible address, so ranges cost nothing when checking */
+    std::vector<bool> m_allowed;
+    std::vector<bool> m_denied;
+    bool m_has_allowed { false };
+};
+
+}
@@ -0,0 +1,175 @@
+/*
+BSD 2-Clause License
+
+Copyright (c) 2020, Till Mayer
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "Framer.hpp"
+#include <cassert>
+#include <util/bch/BchCode.hpp>
+
+using namespace Dsp::PocsagProtocol;
+
+/* Only log invalid preambles that looked like one for a while, random noise would flood the log otherwise */
+static constexpr u32 min_logged_preamble_bits { 25 };
+
+/* All framers share one code, the correction tables are read only */
+static const Bch::Code<Bch::EncodingType::Prefix, 31, 21, 2> s_bch_code { Bch::Z2Polynomial(0b11101101001) };
+
+Framer::Framer(BaudRate baud_rate)
+    : m_log("POCSAG" + std::to_string(baud_rate))
+    , m_baud_rate(baud_rate) {
+}
+
+std::string Framer::state_string(State state) {
+    switch (state) {
+    case State::FirstBitSinceSync:
+        return "Waiting for preamble...";
+    case State::WaitForInitialSyncWord:
+        return "Waiting for sync...";
+    case State::WaitForImmediateSyncWord:
+        return "Waiting for immediate sync...";
+    case State::ReadPocsagBatch:
+        return "Reading batch...";
+    }
+
+    assert(false);
+    return "Invalid";
+}
+
+void Framer::reset() {
+    m_codeword_count = 0;
+    m_inverted = false;
+    m_incoming_buffer.reset();
+    m_preamble_count = 0;
+    m_state = State::FirstBitSinceSync;
+    m_skipping_message = false;
+    m_message_builder = {};
+}
+
+std::optional<Message> Framer::message_done() {
+    std::optional<Message> message;
+    if (m_message_builder.valid())
+        message = m_message_builder.build(m_content_type, m_baud_rate);
+
+    m_message_builder = {};
+    return message;
+}
+
+std::optional<Message> Framer::process_bit(bool sample) {
+    sample ^= m_inverted;
+    m_received_parity ^= sample;
+    m_incoming_buffer.push(sample);
+
+    std::optional<u32> code_word;
+    std::optional<Message> message;
+    switch (m_state) {
+    case State::FirstBitSinceSync:
+        m_last_bit = sample;
+        m_state = State::WaitForInitialSyncWord;
+        break;
+    case State::WaitForInitialSyncWord:
+        m_incoming_buffer.reset_bit_count();
+        if (sample == m_last_bit && m_preamble_count < Data::preamble_bit_count / 4) {
+            if (m_preamble_count >= min_logged_preamble_bits)
+                m_log.info() << "Invalid preamble";
+            reset();
+            return {};
+        }
+
+        m_last_bit = sample;
+        if (++m_preamble_count > Data::preamble_bit_count * 3) {
+            m_log.info() << "Preamble too long!";
+            reset();
+            return {};
+        }
+        [[fallthrough]];
+    case State::WaitForImmediateSyncWord:
+        if (m_state != State::WaitForInitialSyncWord && !m_incoming_buffer.aligned())
+            return {};
+
+        switch (m_sync_detector.match(m_incoming_buffer.data<u32>())) {
+        case SyncDetector::Match::Normal:
+            m_log.info() << "Sync...";
+            break;
+        case SyncDetector::Match::Inverted:
+            /* Bits are already inverted once synced, so this can only be noise between batches */
+            if (m_state == State::WaitForInitialSyncWord) {
+                m_log.info() << "Inverted Sync detected, inverting all other bits from here on out!";
+                m_inverted = true;
+                break;
+            }
+            [[fallthrough]];
+        case SyncDetector::Match::None:
+            if (m_state == State::WaitForInitialSyncWord)
+                return {};
+
+            m_log.info() << "Did not get expected sync codeword, message done.";
+            message = message_done();
+            reset();
+            return message;
+        }
+
+        m_state = State::ReadPocsagBatch;
+        m_received_parity = true;
+        break;
+    case State::ReadPocsagBatch:
+        if (!m_incoming_buffer.aligned())
+            return {};
+
+        /* POCSAG uses even parity */
+        if (!m_received_parity)
+            m_log.info() << "Parity error!";
+
+        code_word = s_bch_code.correct((m_incoming_buffer.data<u32>() >> 1) & ~0x80000000);
+        if (code_word.has_value()) {
+            const auto data = Data::from_codeword(m_codeword_count, code_word.value());
+            if (data.type() == Data::Type::Idle || data.type() == Data::Type::Address) {
+                message = message_done();
+
+                /* Filtered messages are skipped entirely, their content never gets decoded */
+                m_skipping_message = data.type() == Data::Type::Address && m_address_filter && !m_address_filter->accepts(data.contents());
+            }
+
+            if (!m_skipping_message)
+                m_message_builder.append_data(data);
+        } else {
+            m_log.info() << "Could not correct code word!";
+            if (!m_skipping_message)
+                m_message_builder.set_has_invalid_codeword();
+        }
+
+        if (++m_codeword_count >= Message::codewords_per_batch) {
+            m_state = State::WaitForImmediateSyncWord;
+            m_codeword_count = 0;
+        }
+
+        m_received_parity = true;
+        break;
+    default:
+        assert(false);
+    }
+
+    return message;
+}
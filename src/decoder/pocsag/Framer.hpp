@@ -0,0 +1,97 @@
+/*
+BSD 2-Clause License
+
+Copyright (c) 2020, Till Mayer
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#pragma once
+
+#include "AddressFilter.hpp"
+#include "PocsagData.hpp"
+#include "PocsagMessage.hpp"
+#include "SyncDetector.hpp"
+#include <optional>
+#include <string>
+#include <util/BitBuffer.hpp>
+#include <util/BitStream.hpp>
+#include <util/Logger.hpp>
+#include <util/Types.hpp>
+
+namespace Dsp::PocsagProtocol {
+
+/* Finds the sync word and reads batches from the bits of a single baud rate */
+class Framer final {
+public:
+    enum class State : u8 {
+        FirstBitSinceSync,
+        WaitForInitialSyncWord,
+        WaitForImmediateSyncWord,
+        ReadPocsagBatch
+    };
+
+    explicit Framer(BaudRate);
+
+    static std::string state_string(State);
+
+    std::optional<Message> process_bit(bool);
+
+    /* Sync words and codewords can start at any bit, so the bits are still stepped through one by one */
+    template<typename Callback>
+    void process_bits(const BitStream& stream, Callback on_message) {
+        for (u8 i = 0; i < stream.count; ++i) {
+            const auto message = process_bit(stream.get(i));
+            if (message.has_value())
+                on_message(message.value());
+        }
+    }
+
+    void reset();
+    void set_content_type(Message::ContentType content_type) { m_content_type = content_type; }
+    void set_address_filter(const AddressFilter* address_filter) { m_address_filter = address_filter; }
+    void set_max_sync_bit_errors(u8 max_bit_errors) { m_sync_detector.set_max_bit_errors(max_bit_errors); }
+
+    BaudRate baud_rate() const { return m_baud_rate; }
+    State state() const { return m_state; }
+    bool synced() const { return m_state == State::WaitForImmediateSyncWord || m_state == State::ReadPocsagBatch; }
+
+private:
+    std::optional<Message> message_done();
+
+    Logger m_log;
+    BaudRate m_baud_rate;
+    BitBuffer<Util::PushSequence::MsbPushedFirst, Data::codeword_bit_count> m_incoming_buffer;
+    u32 m_preamble_count { 0 };
+    u32 m_codeword_count { 0 };
+    bool m_received_parity { false };
+    bool m_inverted { false };
+    bool m_last_bit { false };
+    bool m_skipping_message { false };
+    State m_state { State::FirstBitSinceSync };
+    SyncDetector m_sync_detector { Data::sync_word };
+    MessageBuilder m_message_builder;
+    Message::ContentType m_content_type { Message::ContentType::AlphaNumeric };
+    const AddressFilter* m_address_filter { nullptr };
+};
+
+}
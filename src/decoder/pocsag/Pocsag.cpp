@@ -27,178 +27,120 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 #include "Pocsag.hpp"
 #include "PocsagMessage.hpp"
-#include <dsp/BitConverter.hpp>
-#include <dsp/FirFilter.hpp>
-#include <dsp/Mapper.hpp>
+#include <dsp/ClockRecovery.hpp>
 #include <dsp/MovingAverage.hpp>
+#include <pipe/Parallel.hpp>
 #include <util/Config.hpp>
 
 using namespace Dsp;
 
 static constexpr SampleRate sample_rate { 12000 };
-static constexpr Samples bits_required_for_sync { 25 };
 
 Pocsag::Pocsag()
-    : Decoder<bool>("POCSAG", sample_rate, DecoderBase::Headless::Yes, 140) {
+    : Decoder<u8>("POCSAG", sample_rate, DecoderBase::Headless::Yes, 140) {
 }
 
-std::string Pocsag::state_string(State state) {
-    switch (state) {
-    case State::FirstBitSinceSync:
-        return "Waiting for preamble...";
-    case State::WaitForInitialSyncWord:
-        return "Waiting for sync...";
-    case State::WaitForImmediateSyncWord:
-        return "Waiting for immediate sync...";
-    case State::ReadPocsagBatch:
-        return "Reading batch...";
+void Pocsag::update_status() {
+    /* Show the state of whichever framer got the furthest */
+    const PocsagProtocol::Framer* furthest = &m_framers[0];
+    for (const auto& framer : m_framers) {
+        if (framer.state() > furthest->state())
+            furthest = &framer;
     }
 
-    assert(false);
-    return "Invalid";
-}
-
-void Pocsag::update_state(State state) {
-    m_state = state;
-    set_status(state_string(state));
-}
+    if (m_shown_state == furthest->state())
+        return;
 
-Fl_Widget* Pocsag::build_ui(Point top_left, Size ui_size) {
-    m_callback_manager.forget_callbacks();
-    auto* root = new Fl_Group(top_left.x(), top_left.y(), ui_size.w(), ui_size.h());
-
-    auto* controls = new Fl_Group(top_left.x(), top_left.y(), ui_size.w(), 44);
-    controls->box(FL_EMBOSSED_BOX);
-    auto control_offset = top_left.translated(4, 4);
-    Size control_size(ui_size.w() - 8, controls->h() - 8);
-
-    m_sync_512_indicator = new Ui::Indicator(control_offset.x(),
-                                             control_offset.y(),
-                                             40,
-                                             control_size.h(),
-                                             Ui::Indicator::yellow_on,
-                                             Ui::Indicator::yellow_off,
-                                             "512");
-    m_sync_512_indicator->set_state(false);
-    control_offset.translate(m_sync_512_indicator->w() + 2, 0);
-
-    m_sync_1200_indicator = new Ui::Indicator(control_offset.x(),
-                                              control_offset.y(),
-                                              40,
-                                              control_size.h(),
-                                              Ui::Indicator::yellow_on,
-                                              Ui::Indicator::yellow_off,
-                                              "1200");
-    m_sync_1200_indicator->set_state(false);
-    control_offset.translate(m_sync_1200_indicator->w() + 2, 0);
-
-    m_sync_2400_indicator = new Ui::Indicator(control_offset.x(),
-                                              control_offset.y(),
-                                              40,
-                                              control_size.h(),
-                                              Ui::Indicator::yellow_on,
-                                              Ui::Indicator::yellow_off,
-                                              "2400");
-    m_sync_2400_indicator->set_state(false);
-    control_offset.translate(m_sync_2400_indicator->w() + 2, 0);
-
-    m_data_indicator = new Ui::Indicator(control_offset.x(),
-                                         control_offset.y(),
-                                         40,
-                                         control_size.h(),
-                                         Ui::Indicator::green_on,
-                                         Ui::Indicator::green_off,
-                                         "Data");
-
-    m_content_selector = new Fl_Choice(top_left.x() + 4 + control_size.w() - 185, control_offset.y(), 135, control_size.h(), "Show: ");
-    for (u8 i = 0; i < static_cast<u8>(PocsagProtocol::Message::ContentType::__Count); ++i)
-        m_content_selector->add(PocsagProtocol::Message::content_name(static_cast<PocsagProtocol::Message::ContentType>(i)).c_str());
-    m_content_selector->value(static_cast<int>(m_content_type));
-
-    m_callback_manager.register_callback(*m_content_selector, [&]() {
-        m_content_type = static_cast<PocsagProtocol::Message::ContentType>(m_content_selector->value());
-    });
-
-    auto* clear_button = new Fl_Button(m_content_selector->x() + m_content_selector->w() + 2, control_offset.y(), 50, control_size.h(), "Clear");
-    m_callback_manager.register_callback(*clear_button, [&]() { m_text_box->clear(); });
-
-    auto* spring = new Fl_Box(m_content_selector->x(), m_content_selector->y(), 0, 0);
-    controls->resizable(spring);
-    controls->end();
-
-    top_left.translate(0, controls->h() + 2);
-    ui_size.resize(0, -controls->h() - 2);
-
-    m_text_box = new Ui::TextDisplay(top_left.x(), top_left.y(), ui_size.w(), ui_size.h());
-    m_text_box->textfont(FL_COURIER);
-    root->resizable(m_text_box);
-    root->end();
-    return root;
+    m_shown_state = furthest->state();
+    if (furthest->synced())
+        set_status(PocsagProtocol::Framer::state_string(furthest->state()) + " (" + std::to_string(furthest->baud_rate()) + " bauds)");
+    else
+        set_status(PocsagProtocol::Framer::state_string(furthest->state()));
 }
 
 void Pocsag::on_setup() {
-    reset(false);
-    if (Drtd::using_ui())
+    if (Drtd::using_ui()) {
         Util::Config::load(config_path("ContentType"), m_content_type, PocsagProtocol::Message::ContentType::AlphaNumeric);
+        Util::Config::load(config_path("SyncBitErrors"), m_max_sync_bit_errors, PocsagProtocol::SyncDetector::default_max_bit_errors);
+    }
+
+    m_address_filter.reset();
+    if (!Drtd::address_filter_file().empty()) {
+        m_address_filter = PocsagProtocol::AddressFilter::load(Drtd::address_filter_file());
+        /* Only fatal in headless mode, the UI reports it and shows all messages */
+        if (!m_address_filter.has_value() && !Drtd::using_ui())
+            Util::die("Could not load the address filter!");
+    }
+
+    for (auto& framer : m_framers)
+        framer.set_address_filter(m_address_filter.has_value() ? &m_address_filter.value() : nullptr);
+
+    update_content_type(m_content_type);
+    update_max_sync_bit_errors(m_max_sync_bit_errors);
+    reset(false);
 }
 
 void Pocsag::on_tear_down() {
-    if (Drtd::using_ui())
+    if (Drtd::using_ui()) {
         Util::Config::save(config_path("ContentType"), m_content_type);
+        Util::Config::save(config_path("SyncBitErrors"), m_max_sync_bit_errors);
+    }
+}
+
+void Pocsag::update_content_type(PocsagProtocol::Message::ContentType content_type) {
+    m_content_type = content_type;
+    for (auto& framer : m_framers)
+        framer.set_content_type(content_type);
+}
+
+void Pocsag::update_max_sync_bit_errors(u8 max_bit_errors) {
+    m_max_sync_bit_errors = max_bit_errors;
+    for (auto& framer : m_framers)
+        framer.set_max_sync_bit_errors(max_bit_errors);
 }
 
 void Pocsag::reset(bool reset_indicators) {
-    if (m_matched_filter.valid())
-        m_matched_filter->set_taps(1);
-
-    if (m_converter.valid())
-        m_converter->wait_for_sync();
-
-    m_codeword_count = 0;
-    m_inverted = false;
-    m_incoming_buffer.reset();
-    m_preamble_count = 0;
-    update_state(State::FirstBitSinceSync);
-    m_message_builder = {};
-
-    if (reset_indicators && Drtd::using_ui()) {
-        m_sync_512_indicator->set_state(false);
-        m_sync_1200_indicator->set_state(false);
-        m_sync_2400_indicator->set_state(false);
-        m_data_indicator->set_state(false);
+    for (auto& framer : m_framers)
+        framer.reset();
+
+    m_shown_state.reset();
+    update_status();
+
+    if (reset_indicators) {
+        for (size_t i = 0; i < m_framers.size(); ++i)
+            show_line_state(i, false, false);
     }
 }
 
-Pipe::Line<float, bool> Pocsag::build_pipeline() {
-    auto moving_average = MovingAverage<float>(1);
-    auto converter = BitConverter(bits_required_for_sync, { 512, 1200, 2400 });
+/* A matched filter and clock recovery for one baud rate */
+static Pipe::Line<float, BitStream> demodulator_line(BaudRate baud_rate) {
+    return Pipe::line(MovingAverage<float>(static_cast<Taps>(std::roundf(static_cast<float>(sample_rate) / baud_rate))),
+                      ClockRecovery(baud_rate, true));
+}
 
-    m_matched_filter = moving_average.make_ref();
-    m_converter = converter.make_ref();
+Pipe::Line<float, u8> Pocsag::build_pipeline() {
+    static_assert(baud_rates.size() <= sizeof(u8) * 8);
 
-    converter.sync_callback = [&](BitConverter::SyncInfo sync_info) {
-        m_matched_filter->set_taps(static_cast<Taps>(std::roundf(sync_info.samples_per_bit)));
+    /* The bits are kept here, and the result only tells which lines produced any */
+    std::function<u8(const Buffer<BitStream>&)> merge_lines = [this](const Buffer<BitStream>& lines) {
+        u8 result = 0;
+        for (size_t i = 0; i < lines.size(); ++i) {
+            m_line_streams[i] = lines[i];
+            if (!lines[i].empty())
+                result |= 1 << i;
+        }
+        return result;
     };
 
-    return Pipe::line(std::move(moving_average),
-                      Mapper<float, bool>([](auto input) { return input < 0; }),
-                      std::move(converter));
+    return Pipe::line(Pipe::parallel(Pipe::MergePolicy::AnyLineProduced,
+                                     merge_lines,
+                                     demodulator_line(baud_rates[0]),
+                                     demodulator_line(baud_rates[1]),
+                                     demodulator_line(baud_rates[2])));
 }
 
-void Pocsag::message_done() {
-    const auto message = m_message_builder.build(m_content_type, static_cast<BaudRate>(m_converter->current_baud_rate()));
-    if (m_message_builder.valid()) {
-        if (Drtd::using_ui()) {
-            const bool scroll = m_text_box->should_autoscroll();
-            m_text_box->buffer()->append(message.str().c_str());
-            if (scroll)
-                m_text_box->scroll_to_bottom();
-        } else {
-            puts(message.str().c_str());
-        }
-    }
-
-    m_message_builder = {};
+void Pocsag::show_message(const PocsagProtocol::Message& message) {
+    puts(message.str().c_str());
 }
 
 Buffer<std::string> Pocsag::changeable_parameters() const {
@@ -222,102 +164,17 @@ bool Pocsag::setup_parameters(const Buffer<std::string>& args) {
     return true;
 }
 
-void Pocsag::process_pipeline_result(bool sample) {
-    const bool update_ui = Drtd::using_ui();
-    sample ^= m_inverted;
-    m_received_parity ^= sample;
-    m_incoming_buffer.push(sample);
-    if (update_ui)
-        m_data_indicator->set_state(sample);
-
-    std::optional<u32> code_word;
-    switch (m_state) {
-    case State::FirstBitSinceSync:
-        m_last_bit = sample;
-        update_state(State::WaitForInitialSyncWord);
-        break;
-    case State::WaitForInitialSyncWord:
-        m_incoming_buffer.reset_bit_count();
-        if (sample == m_last_bit && m_preamble_count < PocsagProtocol::Data::preamble_bit_count / 4) {
-            logger().info() << "Invalid preamble";
-            reset(true);
-            return;
-        }
-
-        m_last_bit = sample;
-        if (++m_preamble_count > PocsagProtocol::Data::preamble_bit_count * 3) {
-            logger().info() << "Preamble too long!";
-            reset(true);
-            return;
-        }
-        [[fallthrough]];
-    case State::WaitForImmediateSyncWord:
-        if (m_state != State::WaitForInitialSyncWord && !m_incoming_buffer.aligned())
-            return;
-
-        code_word = m_incoming_buffer.data<u32>();
-        if (m_state == State::WaitForImmediateSyncWord) {
-            code_word = m_bch_code.correct((code_word.value() >> 1) & ~0x80000000);
-            if (code_word.has_value())
-                code_word = code_word.value() << 1;
-        }
+void Pocsag::process_pipeline_result(u8 lines) {
+    /* All framers run on the same samples, so messages come out in the order they ended on air */
+    for (size_t i = 0; i < m_framers.size(); ++i) {
+        if (!(lines & (1 << i)))
+            continue;
 
-        if (code_word.has_value()) {
-            if (code_word.value() == PocsagProtocol::Data::sync_word) {
-                logger().info() << "Sync...";
-            } else if (code_word.value() == ~PocsagProtocol::Data::sync_word) {
-                logger().info() << "Inverted Sync detected, inverting all other bits from here on out!";
-                if (m_state == State::WaitForInitialSyncWord)
-                    m_inverted = true;
-            } else {
-                break;
-            }
-        } else {
-            logger().info() << "Did not get expected sync codeword, message done.";
-            message_done();
-            reset(true);
-            break;
-        }
-
-        update_state(State::ReadPocsagBatch);
-        if (update_ui) {
-            if (m_converter->current_baud_rate() == 512)
-                m_sync_512_indicator->set_state(true);
-            else if (m_converter->current_baud_rate() == 1200)
-                m_sync_1200_indicator->set_state(true);
-            else if (m_converter->current_baud_rate() == 2400)
-                m_sync_2400_indicator->set_state(true);
-        }
-        m_received_parity = true;
-        break;
-    case State::ReadPocsagBatch:
-        if (!m_incoming_buffer.aligned())
-            return;
-
-        /* POCSAG uses even parity */
-        if (!m_received_parity)
-            logger().info() << "Parity error!";
-
-        code_word = m_bch_code.correct((m_incoming_buffer.data<u32>() >> 1) & ~0x80000000);
-        if (code_word.has_value()) {
-            const auto data = PocsagProtocol::Data::from_codeword(m_codeword_count, code_word.value());
-            if (data.type() == PocsagProtocol::Data::Type::Idle || data.type() == PocsagProtocol::Data::Type::Address)
-                message_done();
-
-            m_message_builder.append_data(data);
-        } else {
-            logger().info() << "Could not correct code word!";
-            m_message_builder.set_has_invalid_codeword();
-        }
-
-        if (++m_codeword_count >= PocsagProtocol::Message::codewords_per_batch) {
-            update_state(State::WaitForImmediateSyncWord);
-            m_codeword_count = 0;
-        }
-
-        m_received_parity = true;
-        break;
-    default:
-        assert(false);
+        auto& framer = m_framers[i];
+        const auto& stream = m_line_streams[i];
+        framer.process_bits(stream, [this](const PocsagProtocol::Message& message) { show_message(message); });
+        show_line_state(i, framer.synced(), stream.newest());
     }
+
+    update_status();
 }
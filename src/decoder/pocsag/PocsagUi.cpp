@@ -0,0 +1,112 @@
+/*
+BSD 2-Clause License
+
+Copyright (c) 2020, Till Mayer
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "PocsagUi.hpp"
+#include <Drtd.hpp>
+#include <FL/Fl_Box.H>
+#include <FL/Fl_Button.H>
+#include <FL/Fl_Group.H>
+
+using namespace Dsp;
+
+static constexpr std::array<const char*, 3> sync_labels { "512", "1200", "2400" };
+
+Fl_Widget* PocsagUi::build_ui(Point top_left, Size ui_size) {
+    m_callback_manager.forget_callbacks();
+    auto* root = new Fl_Group(top_left.x(), top_left.y(), ui_size.w(), ui_size.h());
+
+    auto* controls = new Fl_Group(top_left.x(), top_left.y(), ui_size.w(), 44);
+    controls->box(FL_EMBOSSED_BOX);
+    auto control_offset = top_left.translated(4, 4);
+    Size control_size(ui_size.w() - 8, controls->h() - 8);
+
+    for (size_t i = 0; i < m_sync_indicators.size(); ++i) {
+        m_sync_indicators[i] = new Ui::Indicator(control_offset.x(),
+                                                 control_offset.y(),
+                                                 40,
+                                                 control_size.h(),
+                                                 Ui::Indicator::yellow_on,
+                                                 Ui::Indicator::yellow_off,
+                                                 sync_labels[i]);
+        m_sync_indicators[i]->set_state(false);
+        control_offset.translate(m_sync_indicators[i]->w() + 2, 0);
+    }
+
+    m_data_indicator = new Ui::Indicator(control_offset.x(),
+                                         control_offset.y(),
+                                         40,
+                                         control_size.h(),
+                                         Ui::Indicator::green_on,
+                                         Ui::Indicator::green_off,
+                                         "Data");
+    control_offset.translate(m_data_indicator->w() + 2, 0);
+
+    m_sync_bit_errors = new Fl_Spinner(control_offset.x() + 84, control_offset.y(), 40, control_size.h(), "Sync errors:");
+    m_sync_bit_errors->tooltip("Number of bits allowed to differ when searching for the sync word");
+    m_sync_bit_errors->range(0, PocsagProtocol::SyncDetector::max_max_bit_errors);
+    m_sync_bit_errors->step(1);
+    m_sync_bit_errors->value(m_max_sync_bit_errors);
+    m_callback_manager.register_callback(*m_sync_bit_errors, [&]() {
+        update_max_sync_bit_errors(static_cast<u8>(m_sync_bit_errors->value()));
+    });
+
+    m_content_selector = new Fl_Choice(top_left.x() + 4 + control_size.w() - 185, control_offset.y(), 135, control_size.h(), "Show: ");
+    for (u8 i = 0; i < static_cast<u8>(PocsagProtocol::Message::ContentType::__Count); ++i)
+        m_content_selector->add(PocsagProtocol::Message::content_name(static_cast<PocsagProtocol::Message::ContentType>(i)).c_str());
+    m_content_selector->value(static_cast<int>(m_content_type));
+
+    m_callback_manager.register_callback(*m_content_selector, [&]() {
+        update_content_type(static_cast<PocsagProtocol::Message::ContentType>(m_content_selector->value()));
+    });
+
+    auto* clear_button = new Fl_Button(m_content_selector->x() + m_content_selector->w() + 2, control_offset.y(), 50, control_size.h(), "Clear");
+    m_callback_manager.register_callback(*clear_button, [&]() { m_text_box->clear(); });
+
+    auto* spring = new Fl_Box(m_content_selector->x(), m_content_selector->y(), 0, 0);
+    controls->resizable(spring);
+    controls->end();
+
+    top_left.translate(0, controls->h() + 2);
+    ui_size.resize(0, -controls->h() - 2);
+
+    m_text_box = new Ui::TextDisplay(top_left.x(), top_left.y(), ui_size.w(), ui_size.h());
+    m_text_box->textfont(FL_COURIER);
+    if (!Drtd::address_filter_file().empty() && !m_address_filter.has_value())
+        m_text_box->append("Could not load the address filter, showing all messages\n");
+    root->resizable(m_text_box);
+    root->end();
+    return root;
+}
+
+void PocsagUi::show_message(const PocsagProtocol::Message& message) {
+    m_text_box->append(message.str());
+}
+
+void PocsagUi::show_line_state(size_t line, bool synced, bool data) {
+    m_sync_indicators[line]->set_state(synced);
+    m_data_indicator->set_state(data);
+}
@@ -0,0 +1,56 @@
+/*
+BSD 2-Clause License
+
+Copyright (c) 2020, Till Mayer
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#pragma once
+
+#include "Pocsag.hpp"
+#include <FL/Fl_Choice.H>
+#include <FL/Fl_Spinner.H>
+#include <ui/component/Indicator.hpp>
+#include <ui/component/TextDisplay.hpp>
+#include <util/CallbackManager.hpp>
+
+namespace Dsp {
+
+class PocsagUi final : public Pocsag {
+public:
+    virtual Fl_Widget* build_ui(Util::Point top_left, Util::Size ui_size) override;
+
+protected:
+    virtual void show_message(const PocsagProtocol::Message&) override;
+    virtual void show_line_state(size_t line, bool synced, bool data) override;
+
+private:
+    CallbackManager m_callback_manager;
+    std::array<Ui::Indicator*, baud_rates.size()> m_sync_indicators {};
+    Ui::Indicator* m_data_indicator { nullptr };
+    Ui::TextDisplay* m_text_box { nullptr };
+    Fl_Choice* m_content_selector { nullptr };
+    Fl_Spinner* m_sync_bit_errors { nullptr };
+};
+
+}
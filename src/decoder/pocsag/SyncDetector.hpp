@@ -0,0 +1,74 @@
+/*
+BSD 2-Clause License
+
+Copyright (c) 2020, Till Mayer
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#pragma once
+
+#include <util/Types.hpp>
+
+namespace Dsp::PocsagProtocol {
+
+/*
+ * Compares 32 bit windows of the received bits against a sync word and its inverse. A window matches
+ * if at most max_bit_errors bits differ, which is a single xor and popcount.
+ */
+class SyncDetector final {
+public:
+    static constexpr u8 default_max_bit_errors { 2 };
+    static constexpr u8 max_max_bit_errors { 6 };
+    static constexpr u8 window_bit_count { 32 };
+
+    enum class Match : u8 {
+        None,
+        Normal,
+        Inverted
+    };
+
+    explicit SyncDetector(u32 sync_word, u8 max_bit_errors = default_max_bit_errors)
+        : m_sync_word(sync_word)
+        , m_max_bit_errors(max_bit_errors) {}
+
+    void set_max_bit_errors(u8 max_bit_errors) { m_max_bit_errors = max_bit_errors; }
+    u8 max_bit_errors() const { return m_max_bit_errors; }
+
+    Match match(u32 window) const {
+        const auto bit_errors = static_cast<u8>(__builtin_popcount(window ^ m_sync_word));
+        if (bit_errors <= m_max_bit_errors)
+            return Match::Normal;
+
+        /* The inverse differs in exactly the bits the window matches */
+        if (window_bit_count - bit_errors <= m_max_bit_errors)
+            return Match::Inverted;
+
+        return Match::None;
+    }
+
+private:
+    u32 m_sync_word;
+    u8 m_max_bit_errors;
+};
+
+}
@@ -0,0 +1,119 @@
+/*
+BSD 2-Clause License
+
+Copyright (c) 2020, Till Mayer
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "BaudotDecoder.hpp"
+#include <array>
+
+using namespace Dsp::RttyProtocol;
+
+struct BaudotCode {
+    constexpr BaudotCode() = default;
+
+    constexpr BaudotCode(const char* letter_str, const char* figure_str)
+        : letter(letter_str)
+        , figure(figure_str) {}
+
+    const char* letter { nullptr };
+    const char* figure { nullptr };
+};
+
+static constexpr u8 figures { 0x1B };
+static constexpr u8 letters { 0x1F };
+static constexpr std::array baudot_codes {
+    BaudotCode("", ""),
+    BaudotCode("E", "3"),
+    BaudotCode("\n", "\n"),
+    BaudotCode("A", "-"),
+    BaudotCode(" ", " "),
+    BaudotCode("S", "<BEL>"),
+    BaudotCode("I", "8"),
+    BaudotCode("U", "7"),
+    BaudotCode("\r", "\r"),
+    BaudotCode("D", "$"),
+    BaudotCode("R", "4"),
+    BaudotCode("J", "'"),
+    BaudotCode("N", ","),
+    BaudotCode("F", "!"),
+    BaudotCode("C", ":"),
+    BaudotCode("K", "("),
+    BaudotCode("T", "5"),
+    BaudotCode("Z", "\""),
+    BaudotCode("L", ")"),
+    BaudotCode("W", "2"),
+    BaudotCode("H", "#"),
+    BaudotCode("Y", "6"),
+    BaudotCode("P", "0"),
+    BaudotCode("Q", "1"),
+    BaudotCode("O", "9"),
+    BaudotCode("B", "?"),
+    BaudotCode("G", "&"),
+    BaudotCode(), //FIGURES is 0x1B
+    BaudotCode("M", "."),
+    BaudotCode("X", "/"),
+    BaudotCode("V", ";"),
+    BaudotCode() //LETTERS is 0x1F
+};
+
+void BaudotDecoder::reset() {
+    m_input_buffer.reset();
+    m_wait_start = true;
+    m_figures = false;
+}
+
+const char* BaudotDecoder::process_bit(bool sample) {
+    /*
+     *   RTTY is "idle on mark"
+     *   Start bit  5 Baudot bits  1, 1.5 or 2 stop bits
+     *   0          XXXXX          1(1)
+     */
+
+    m_input_buffer.push(sample);
+
+    if (m_wait_start && !m_input_buffer.get(0) && m_input_buffer.get(6)) {
+        m_wait_start = false;
+        m_input_buffer.reset_bit_count();
+    } else if (m_wait_start || !m_input_buffer.aligned()) {
+        return nullptr;
+    }
+
+    if (m_input_buffer.get(0) || !m_input_buffer.get(6)) {
+        m_wait_start = true;
+        return nullptr;
+    }
+
+    u8 bits = (m_input_buffer.data<u8>() >> 1) & 0x1F;
+    if (bits == letters) {
+        m_figures = false;
+    } else if (bits == figures) {
+        m_figures = true;
+    } else {
+        BaudotCode code = baudot_codes[bits];
+        return m_figures ? code.figure : code.letter;
+    }
+
+    return nullptr;
+}
@@ -0,0 +1,91 @@
+/*
+BSD 2-Clause License
+
+Copyright (c) 2020, Till Mayer
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "Channel.hpp"
+#include <algorithm>
+#include <dsp/ClockRecovery.hpp>
+#include <dsp/Decimator.hpp>
+#include <dsp/IQMixer.hpp>
+#include <dsp/Mapper.hpp>
+#include <dsp/MovingAverage.hpp>
+#include <dsp/Normalizer.hpp>
+#include <pipe/Parallel.hpp>
+#include <util/Cmplx.hpp>
+
+using namespace Dsp::RttyProtocol;
+
+/* Mixer, matched filter and envelope of one tone */
+static Pipe::Line<float, float> tone_detector(Hertz frequency, Samples samples_per_bit, Samples decimated_samples_per_bit, u16 decimation) {
+    return Pipe::line(Dsp::IQMixer(frequency),
+                      Dsp::MovingAverage<Cmplx>(samples_per_bit),
+                      Dsp::Decimator<Cmplx>(decimation),
+                      Dsp::Mapper<Cmplx, float>([](Cmplx in) { return in.magnitude_squared(); }),
+                      /* At least 6 bits can be zero */
+                      Dsp::Normalizer(decimated_samples_per_bit * 7, Dsp::Normalizer::Lookahead::Yes, Dsp::Normalizer::OffsetMode::Minimum));
+}
+
+Channel::Channel(SampleRate sample_rate, Parameters parameters)
+    : m_parameters(parameters) {
+    const Samples samples_per_bit = static_cast<Samples>(sample_rate / parameters.baud_rate);
+    const Samples decimated_samples_per_bit = std::max<Samples>(1, samples_per_bit / decimation);
+    const Hertz space = parameters.center_frequency - parameters.shift / 2;
+    const Hertz mark = parameters.center_frequency + parameters.shift / 2;
+
+    std::function<float(const Buffer<float>&)> compare_mark_space = [](const Buffer<float>& results) {
+        return results[0] - results[1];
+    };
+
+    m_pipeline = std::make_unique<Pipe::Line<float, BitStream>>(
+        Pipe::line(Pipe::parallel(compare_mark_space,
+                                  tone_detector(mark, samples_per_bit, decimated_samples_per_bit, decimation),
+                                  tone_detector(space, samples_per_bit, decimated_samples_per_bit, decimation)),
+                   ClockRecovery(parameters.baud_rate, parameters.swap_mark_and_space, 0, BaudotDecoder::character_bits)));
+
+    int id = Pipe::GenericComponent::hidden_first_id;
+    m_pipeline->init(sample_rate, id);
+}
+
+void Channel::process(const float* samples, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        Pipe::GenericComponent::prepare_processing();
+        const BitStream stream = m_pipeline->run(samples[i]);
+        if (Pipe::GenericComponent::did_abort_processing())
+            continue;
+
+        for (u8 bit = 0; bit < stream.count; ++bit) {
+            const char* text = m_baudot_decoder.process_bit(stream.get(bit));
+            if (text)
+                m_text += text;
+        }
+    }
+}
+
+std::string Channel::take_text() {
+    std::string text;
+    std::swap(text, m_text);
+    return text;
+}
@@ -0,0 +1,68 @@
+/*
+BSD 2-Clause License
+
+Copyright (c) 2020, Till Mayer
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#pragma once
+
+#include "BaudotDecoder.hpp"
+#include <memory>
+#include <pipe/Line.hpp>
+#include <string>
+#include <util/BitStream.hpp>
+#include <util/Types.hpp>
+
+namespace Dsp::RttyProtocol {
+
+/*
+ * Demodulates a single RTTY signal at a fixed frequency, collecting the text until it is taken. Channels share
+ * nothing with each other, so several of them can process the same samples on different threads.
+ */
+class Channel final {
+public:
+    struct Parameters {
+        Hertz center_frequency;
+        Hertz shift;
+        float baud_rate;
+        bool swap_mark_and_space;
+    };
+
+    Channel(SampleRate, Parameters);
+
+    void process(const float* samples, size_t count);
+    std::string take_text();
+    const Parameters& parameters() const { return m_parameters; }
+
+private:
+    /* Everything after the matched filters runs at a few samples per bit */
+    static constexpr u16 decimation { 7 };
+
+    Parameters m_parameters;
+    std::unique_ptr<Pipe::Line<float, BitStream>> m_pipeline;
+    BaudotDecoder m_baudot_decoder;
+    std::string m_text;
+};
+
+}
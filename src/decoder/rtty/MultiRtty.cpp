@@ -0,0 +1,340 @@
+/*
+BSD 2-Clause License
+
+Copyright (c) 2020, Till Mayer
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "MultiRtty.hpp"
+#include <algorithm>
+#include <cmath>
+#include <dsp/Mapper.hpp>
+#include <dsp/Window.hpp>
+#include <util/Config.hpp>
+#include <vector>
+
+using namespace Dsp;
+
+MultiRtty::MultiRtty()
+    : Decoder<bool>("MultiRTTY", sample_rate, DecoderBase::Headless::Yes, 300)
+    , m_block(block_size)
+    , m_detection_window(detection_fft_size)
+    , m_detection_samples(detection_fft_size)
+    , m_average_power(detection_fft_size / 2) {
+}
+
+void MultiRtty::on_setup() {
+    if (Drtd::using_ui())
+        Util::Config::load(config_path("Settings"), m_settings, {});
+
+    m_worker_pool = std::make_unique<WorkerPool>();
+    logger().info() << "Decoding channels on " << (m_worker_pool->thread_count() + 1) << " threads";
+
+    m_detection_fft = FFT(detection_fft_size);
+    Window::make(WindowType::Hann).calculate_coefficients(m_detection_window);
+    std::fill(m_average_power.begin(), m_average_power.end(), 0);
+    m_block_fill = 0;
+    m_detection_fill = 0;
+    m_averaged_frames = 0;
+    m_detection_round = 0;
+    close_channels();
+}
+
+void MultiRtty::on_tear_down() {
+    if (Drtd::using_ui())
+        Util::Config::save(config_path("Settings"), m_settings);
+
+    close_channels();
+    m_worker_pool.reset();
+}
+
+void MultiRtty::close_channels() {
+    for (auto& slot : m_slots) {
+        slot.channel.reset();
+        slot.text.clear();
+        slot.reopened = false;
+        slot.headless_line.clear();
+    }
+
+    /* The labels are updated with the next result, the UI might not exist yet */
+    m_text_pending = false;
+    m_channels_changed = true;
+    update_marker();
+}
+
+void MultiRtty::update_marker() {
+    Util::MarkerGroup group;
+    const Hertz bandwidth = static_cast<Hertz>(m_settings.baud_rate);
+    for (const auto& slot : m_slots) {
+        if (!slot.channel)
+            continue;
+
+        const i32 offset = static_cast<i32>(slot.frequency) - static_cast<i32>(center_frequency());
+        group.markers.push_back({ .offset = offset - static_cast<i32>(m_settings.shift) / 2, .bandwidth = bandwidth });
+        group.markers.push_back({ .offset = offset + static_cast<i32>(m_settings.shift) / 2, .bandwidth = bandwidth });
+    }
+
+    set_marker(std::move(group));
+}
+
+Pipe::Line<float, bool> MultiRtty::build_pipeline() {
+    return Pipe::line(Mapper<float, bool>([&](float sample) { return process_sample(sample); }));
+}
+
+void MultiRtty::show_text(u8 index, const std::string& text) {
+    /* Channels are printed a line at a time, so their text does not get mixed up */
+    auto& slot = m_slots[index];
+    for (char c : text) {
+        if (c != '\n' && c != '\r')
+            slot.headless_line += c;
+
+        if ((c == '\n' && !slot.headless_line.empty()) || slot.headless_line.size() >= max_headless_line_length) {
+            printf("%u Hz: %s\n", slot.frequency, slot.headless_line.c_str());
+            std::fflush(stdout);
+            slot.headless_line.clear();
+        }
+    }
+}
+
+void MultiRtty::process_block() {
+    std::array<u8, max_channels> active {};
+    u8 active_count = 0;
+    for (u8 i = 0; i < max_channels; ++i) {
+        if (m_slots[i].channel)
+            active[active_count++] = i;
+    }
+
+    m_worker_pool->run(active_count, [&](size_t job) {
+        m_slots[active[job]].channel->process(m_block.ptr(), m_block.size());
+    });
+
+    for (u8 i = 0; i < active_count; ++i) {
+        auto& slot = m_slots[active[i]];
+        slot.text += slot.channel->take_text();
+        m_text_pending |= !slot.text.empty();
+    }
+}
+
+void MultiRtty::detect_signals() {
+    ++m_detection_round;
+
+    const float bins_per_hertz = static_cast<float>(detection_fft_size) / sample_rate;
+    const size_t first_bin = static_cast<size_t>(std::ceil(min_frequency * bins_per_hertz));
+    const size_t last_bin = std::min(m_average_power.size() - 2, static_cast<size_t>(max_frequency * bins_per_hertz));
+    const size_t shift_bins = static_cast<size_t>(std::round(m_settings.shift * bins_per_hertz));
+
+    std::array<Hertz, max_channels> detected {};
+    u8 detected_count = 0;
+    if (shift_bins >= 3 && first_bin + shift_bins < last_bin) {
+        std::vector<float> sorted(m_average_power.ptr() + first_bin, m_average_power.ptr() + last_bin + 1);
+        std::nth_element(sorted.begin(), sorted.begin() + sorted.size() / 2, sorted.end());
+        const float min_power = sorted[sorted.size() / 2] * std::pow(10.f, m_settings.threshold_db / 10.f);
+
+        /* The tones may fall between two bins, so each one is taken as the strongest of three */
+        auto tone_power = [&](size_t bin) {
+            return std::max({ m_average_power[bin - 1], m_average_power[bin], m_average_power[bin + 1] });
+        };
+
+        /* A pair of tones is only as strong as the weaker of the two */
+        std::vector<std::pair<float, size_t>> candidates;
+        for (size_t bin = first_bin; bin + shift_bins <= last_bin; ++bin) {
+            const float power = std::min(tone_power(bin), tone_power(bin + shift_bins));
+            if (power >= min_power)
+                candidates.emplace_back(power, bin);
+        }
+
+        std::sort(candidates.begin(), candidates.end(), [](const auto& a, const auto& b) { return a.first > b.first; });
+
+        std::array<size_t, max_channels> taken_bins {};
+        for (const auto& [power, bin] : candidates) {
+            if (detected_count == max_channels)
+                break;
+
+            /* Pairs that share a tone with a stronger one are the same signal */
+            bool overlaps = false;
+            for (u8 i = 0; i < detected_count; ++i)
+                overlaps |= static_cast<size_t>(std::abs(static_cast<long>(bin) - static_cast<long>(taken_bins[i]))) <= shift_bins + 2;
+
+            if (overlaps)
+                continue;
+
+            taken_bins[detected_count] = bin;
+            detected[detected_count++] = static_cast<Hertz>(std::round((static_cast<float>(bin) + shift_bins / 2.f) / bins_per_hertz));
+        }
+    }
+
+    update_channels(detected, detected_count);
+}
+
+void MultiRtty::update_channels(const std::array<Hertz, max_channels>& detected, u8 detected_count) {
+    const Hertz tolerance = std::max<Hertz>(m_settings.shift / 4, 10);
+    bool changed = false;
+
+    for (u8 i = 0; i < detected_count; ++i) {
+        Slot* free_slot = nullptr;
+        bool known = false;
+        for (auto& slot : m_slots) {
+            if (!slot.channel) {
+                if (!free_slot)
+                    free_slot = &slot;
+                continue;
+            }
+
+            if (static_cast<Hertz>(std::abs(static_cast<i32>(slot.channel->parameters().center_frequency) - static_cast<i32>(detected[i]))) <= tolerance) {
+                slot.last_seen_round = m_detection_round;
+                known = true;
+                break;
+            }
+        }
+
+        if (known || !free_slot)
+            continue;
+
+        logger().info() << "Signal at " << detected[i] << " Hz";
+        free_slot->channel = std::make_unique<RttyProtocol::Channel>(
+            sample_rate,
+            RttyProtocol::Channel::Parameters { detected[i], m_settings.shift, m_settings.baud_rate, m_settings.swap_mark_and_space });
+        free_slot->frequency = detected[i];
+        free_slot->last_seen_round = m_detection_round;
+        free_slot->reopened = true;
+        changed = true;
+    }
+
+    for (auto& slot : m_slots) {
+        if (slot.channel && m_detection_round - slot.last_seen_round >= channel_timeout_rounds) {
+            logger().info() << "Lost signal at " << slot.frequency << " Hz";
+            slot.channel.reset();
+            changed = true;
+        }
+    }
+
+    m_channels_changed |= changed;
+}
+
+bool MultiRtty::process_sample(float sample) {
+    m_block[m_block_fill++] = sample;
+    m_detection_samples[m_detection_fill++] = sample;
+    const bool block_full = m_block_fill == m_block.size();
+    const bool detection_frame_full = m_detection_fill == m_detection_samples.size();
+
+    if (block_full || detection_frame_full) {
+        /* This takes a while, so the UI is only locked to show the results. Settings change under the processing lock */
+        Util::UiUnlock unlock(Drtd::using_ui());
+        if (block_full) {
+            process_block();
+            m_block_fill = 0;
+        }
+
+        if (detection_frame_full) {
+            add_detection_frame();
+            m_detection_fill = 0;
+        }
+    }
+
+    /* Without anything new to show, the UI is neither locked nor woken up */
+    const bool new_results = m_text_pending || m_channels_changed;
+    if (!new_results)
+        Pipe::GenericComponent::abort_processing();
+
+    return new_results;
+}
+
+void MultiRtty::add_detection_frame() {
+    auto& input = m_detection_fft.input_buffer();
+    for (size_t i = 0; i < detection_fft_size; ++i)
+        input[i] = m_detection_samples[i] * m_detection_window[i];
+
+    m_detection_fft.execute();
+    const auto& output = m_detection_fft.output_buffer();
+    for (size_t i = 0; i < m_average_power.size(); ++i)
+        m_average_power[i] += output[i][0] * output[i][0] + output[i][1] * output[i][1];
+
+    if (++m_averaged_frames < detection_frames)
+        return;
+
+    detect_signals();
+    std::fill(m_average_power.begin(), m_average_power.end(), 0);
+    m_averaged_frames = 0;
+}
+
+void MultiRtty::process_pipeline_result(bool new_results) {
+    if (!new_results)
+        return;
+
+    if (m_text_pending) {
+        for (u8 i = 0; i < max_channels; ++i) {
+            auto& slot = m_slots[i];
+            if (!slot.text.empty()) {
+                show_text(i, slot.text);
+                slot.text.clear();
+            }
+        }
+
+        m_text_pending = false;
+    }
+
+    if (m_channels_changed) {
+        for (u8 i = 0; i < max_channels; ++i) {
+            auto& slot = m_slots[i];
+            if (slot.reopened) {
+                slot.reopened = false;
+                slot.headless_line.clear();
+                clear_text(i);
+            }
+
+            update_slot_label(i);
+        }
+
+        update_marker();
+        m_channels_changed = false;
+    }
+}
+
+Util::Buffer<std::string> MultiRtty::changeable_parameters() const {
+    return { "Shift (Integer)", "Baud rate (Float)", "USB/LSB" };
+}
+
+bool MultiRtty::setup_parameters(const Util::Buffer<std::string>& parameters) {
+    assert(parameters.size() == 3);
+    int shift = Util::parse_int(parameters[0]).value_or(-1);
+    if (shift < 10) {
+        puts("Invalid shift!");
+        return false;
+    }
+
+    float baud_rate = Util::parse_float(parameters[1]).value_or(-1);
+    if (baud_rate < 10) {
+        puts("Invalid baud rate!");
+        return false;
+    }
+
+    if (Util::to_lower(parameters[2]) != "usb" && Util::to_lower(parameters[2]) != "lsb") {
+        puts("Provide either USB or LSB");
+        return false;
+    }
+
+    m_settings.shift = shift;
+    m_settings.baud_rate = baud_rate;
+    m_settings.swap_mark_and_space = Util::to_lower(parameters[2]) == "lsb";
+    return true;
+}
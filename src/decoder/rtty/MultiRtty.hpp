@@ -0,0 +1,119 @@
+/*
+BSD 2-Clause License
+
+Copyright (c) 2020, Till Mayer
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#pragma once
+
+#include "Channel.hpp"
+#include <array>
+#include <decoder/Decoder.hpp>
+#include <memory>
+#include <util/FFT.hpp>
+#include <util/WorkerPool.hpp>
+
+namespace Dsp {
+
+/*
+ * Finds RTTY signals with the configured shift anywhere in the passband, and decodes all of them at once. The
+ * pipeline does the decoding, and only produces a result when there is something new to show.
+ */
+class MultiRtty : public Decoder<bool> {
+public:
+    MultiRtty();
+
+    virtual Util::Buffer<std::string> changeable_parameters() const override;
+    virtual bool setup_parameters(const Util::Buffer<std::string>&) override;
+
+protected:
+    static constexpr u8 max_channels { 6 };
+
+    struct Settings {
+        bool swap_mark_and_space { false };
+        Hertz shift { 170 };
+        float baud_rate { 45.45 };
+        u8 threshold_db { 10 };
+    };
+
+    struct Slot {
+        std::unique_ptr<RttyProtocol::Channel> channel;
+        Hertz frequency { 0 };
+        u32 last_seen_round { 0 };
+        /* Decoded, but not shown yet */
+        std::string text;
+        /* A new channel was opened, the text of the previous one is still shown */
+        bool reopened { false };
+        std::string headless_line;
+    };
+
+    virtual Pipe::Line<float, bool> build_pipeline() override;
+    virtual void process_pipeline_result(bool) override;
+    virtual void on_setup() override;
+    virtual void on_tear_down() override;
+    /* Without a UI, the channels are printed a line at a time */
+    virtual void show_text(u8 index, const std::string&);
+    virtual void clear_text(u8) {}
+    virtual void update_slot_label(u8) {}
+    void close_channels();
+
+    Settings m_settings;
+    std::array<Slot, max_channels> m_slots {};
+
+private:
+    static constexpr SampleRate sample_rate { 7350 };
+    /* Channels process the samples in blocks, one job per channel on the worker pool */
+    static constexpr size_t block_size { sample_rate / 10 };
+    /* About 3.6Hz per bin, a few spectra are averaged before looking for signals */
+    static constexpr size_t detection_fft_size { 2048 };
+    static constexpr u8 detection_frames { 4 };
+    static constexpr Hertz min_frequency { 300 };
+    static constexpr Hertz max_frequency { 3300 };
+    /* A channel is closed if its signal was not seen for this many detection rounds */
+    static constexpr u8 channel_timeout_rounds { 10 };
+    /* Lines are printed once they are complete, or this long when running headless */
+    static constexpr size_t max_headless_line_length { 80 };
+
+    void detect_signals();
+    void update_channels(const std::array<Hertz, max_channels>& detected, u8 detected_count);
+    void update_marker();
+    bool process_sample(float);
+    void process_block();
+    void add_detection_frame();
+
+    std::unique_ptr<WorkerPool> m_worker_pool;
+    Buffer<float> m_block;
+    size_t m_block_fill { 0 };
+    FFT m_detection_fft;
+    Buffer<float> m_detection_window;
+    Buffer<float> m_detection_samples;
+    Buffer<float> m_average_power;
+    size_t m_detection_fill { 0 };
+    u8 m_averaged_frames { 0 };
+    u32 m_detection_round { 0 };
+    bool m_text_pending { false };
+    bool m_channels_changed { false };
+};
+
+}
@@ -0,0 +1,151 @@
+/*
+BSD 2-Clause License
+
+Copyright (c) 2020, Till Mayer
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "MultiRttyUi.hpp"
+#include <FL/Fl_Box.H>
+#include <FL/Fl_Button.H>
+#include <FL/Fl_Check_Button.H>
+#include <FL/Fl_Group.H>
+#include <FL/Fl_Spinner.H>
+#include <thread/ProcessingThread.hpp>
+
+using namespace Dsp;
+
+void MultiRttyUi::on_tear_down() {
+    MultiRtty::on_tear_down();
+
+    /* The text boxes are deleted with the rest of the decoder UI */
+    m_text_boxes.fill(nullptr);
+}
+
+void MultiRttyUi::update_slot_label(u8 index) {
+    auto* text_box = m_text_boxes[index];
+    if (!text_box)
+        return;
+
+    const auto& slot = m_slots[index];
+    if (slot.channel)
+        text_box->copy_label((std::to_string(slot.frequency) + " Hz").c_str());
+    else
+        text_box->copy_label("No signal");
+}
+
+Fl_Widget* MultiRttyUi::build_ui(Point top_left, Size ui_size) {
+    m_callback_manager.forget_callbacks();
+
+    auto* root = new Fl_Group(top_left.x(), top_left.y(), ui_size.w(), ui_size.h());
+    auto* controls = new Fl_Group(top_left.x(), top_left.y(), ui_size.w(), 70);
+    controls->box(FL_EMBOSSED_BOX);
+    auto control_offset = top_left.translated(4, 4);
+    Size control_size(ui_size.w() - 8, controls->h() - 8);
+
+    auto* shift = new Fl_Spinner(control_offset.x() + 75, control_offset.y(), 100, 30, "Shift:");
+    shift->value(m_settings.shift);
+    shift->step(1);
+    shift->range(10, 1000);
+    m_callback_manager.register_callback(*shift, [&, shift]() {
+        Dsp::ProcessingLock lock;
+        m_settings.shift = static_cast<Hertz>(shift->value());
+        close_channels();
+    });
+
+    auto* baud_rate = new Fl_Spinner(shift->x(), shift->y() + shift->h() + 2, shift->w(), 30, "Baudrate:");
+    baud_rate->value(m_settings.baud_rate);
+    baud_rate->step(.01);
+    baud_rate->range(10, 300);
+    m_callback_manager.register_callback(*baud_rate, [&, baud_rate]() {
+        Dsp::ProcessingLock lock;
+        m_settings.baud_rate = static_cast<float>(baud_rate->value());
+        close_channels();
+    });
+
+    auto* threshold = new Fl_Spinner(shift->x() + shift->w() + 90, shift->y(), 60, 30, "Threshold:");
+    threshold->tooltip("How far above the noise floor both tones of a signal have to be, in dB");
+    threshold->value(m_settings.threshold_db);
+    threshold->step(1);
+    threshold->range(3, 40);
+    m_callback_manager.register_callback(*threshold, [&, threshold]() {
+        Dsp::ProcessingLock lock;
+        m_settings.threshold_db = static_cast<u8>(threshold->value());
+    });
+
+    auto* mark_space_swap = new Fl_Check_Button(threshold->x() - 85, baud_rate->y(), 175, 30, "Swap mark and space");
+    mark_space_swap->value(m_settings.swap_mark_and_space);
+    m_callback_manager.register_callback(*mark_space_swap, [&, mark_space_swap]() {
+        Dsp::ProcessingLock lock;
+        m_settings.swap_mark_and_space = static_cast<bool>(mark_space_swap->value());
+        close_channels();
+    });
+
+    auto* clear_button = new Fl_Button(control_offset.x() + control_size.w() - 60,
+                                       control_offset.y() + Util::center(control_size.h(), 30),
+                                       60,
+                                       30,
+                                       "Clear");
+    m_callback_manager.register_callback(*clear_button, [&]() {
+        for (auto* text_box : m_text_boxes)
+            text_box->clear();
+    });
+
+    auto* spring = new Fl_Box(clear_button->x(), clear_button->y(), 0, 0);
+    controls->resizable(spring);
+    controls->end();
+
+    top_left.translate(0, controls->h() + 2);
+    ui_size.resize(0, -controls->h() - 2);
+
+    /* Two columns of text displays, every one with its label above it */
+    static constexpr u8 columns = 2;
+    static constexpr u8 rows = (max_channels + columns - 1) / columns;
+    static constexpr int label_height = 16;
+    auto* grid = new Fl_Group(top_left.x(), top_left.y(), ui_size.w(), ui_size.h());
+    const int cell_width = static_cast<int>(ui_size.w()) / columns;
+    const int cell_height = static_cast<int>(ui_size.h()) / rows;
+    for (u8 i = 0; i < max_channels; ++i) {
+        const int x = top_left.x() + (i % columns) * cell_width;
+        const int y = top_left.y() + (i / columns) * cell_height;
+        auto* text_box = new Ui::TextDisplay(x + 1, y + label_height, cell_width - 2, cell_height - label_height - 1);
+        text_box->align(FL_ALIGN_TOP_LEFT);
+        text_box->labelsize(12);
+        m_text_boxes[i] = text_box;
+        update_slot_label(i);
+    }
+    grid->end();
+
+    root->resizable(grid);
+    root->end();
+    return root;
+}
+
+void MultiRttyUi::show_text(u8 index, const std::string& text) {
+    m_text_boxes[index]->append(text);
+}
+
+void MultiRttyUi::clear_text(u8 index) {
+    if (m_text_boxes[index])
+        m_text_boxes[index]->clear();
+}
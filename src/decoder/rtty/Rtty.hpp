@@ -27,22 +27,20 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 #pragma once
 
-#include <FL/Fl_Check_Button.H>
+#include "BaudotDecoder.hpp"
 #include <decoder/Decoder.hpp>
-#include <dsp/BitConverter.hpp>
+#include <dsp/ClockRecovery.hpp>
+#include <dsp/Decimator.hpp>
 #include <dsp/IQMixer.hpp>
 #include <dsp/MovingAverage.hpp>
 #include <dsp/Normalizer.hpp>
-#include <ui/component/TextDisplay.hpp>
-#include <ui/component/XYScope.hpp>
-#include <util/BitBuffer.hpp>
-#include <util/CallbackManager.hpp>
+#include <util/BitStream.hpp>
 #include <util/Util.hpp>
 #include <util/SNRCalculator.hpp>
 
 namespace Dsp {
 
-class Rtty final : public Decoder<bool> {
+class Rtty : public Decoder<BitStream> {
 public:
     Rtty();
 
@@ -50,16 +48,8 @@ public:
     virtual bool setup_parameters(const Util::Buffer<std::string>&) override;
 
 protected:
-    virtual Pipe::Line<float, bool> build_pipeline() override;
-    Fl_Widget* build_ui(Util::Point, Util::Size) override;
-    void process_pipeline_result(bool) override;
-    virtual void on_setup() override;
-    virtual void on_tear_down() override;
-    virtual void on_marker_move(Hertz) override;
-
-private:
-    static constexpr SampleRate sample_rate { 7350 };
-    static constexpr float scope_phase_step { Util::two_pi_f * (1000.f / sample_rate) };
+    /* Everything after the matched filters runs at a few samples per bit */
+    static constexpr u16 decimation { 7 };
 
     struct Settings {
         bool swap_mark_and_space { false };
@@ -68,28 +58,36 @@ private:
         float baud_rate { 45.45 };
     };
 
+    virtual Pipe::Line<float, BitStream> build_pipeline() override;
+    void process_pipeline_result(BitStream) override;
+    virtual void on_setup() override;
+    virtual void on_tear_down() override;
+    virtual void on_marker_move(Hertz) override;
+    /* Without a UI, the text is printed and there is no tuning scope */
+    virtual void show_text(const char*);
+    virtual void update_scope(float, float) {}
     void update_mixers();
     void update_marker();
     void update_filters();
-    void update_scope(float, float);
+
+    Settings m_settings;
+    ConfigRef<ClockRecovery> m_clock_recovery;
+
+private:
+    static constexpr SampleRate sample_rate { 7350 };
+    static constexpr SampleRate decimated_sample_rate { sample_rate / decimation };
+
+    void process_bit(bool);
 
     Util::SNRCalculator m_mark_snr;
     Util::SNRCalculator m_space_snr;
-    Settings m_settings;
-    float m_scope_phase { 0 };
-    bool m_wait_start { true };
-    bool m_figures { false };
     ConfigRef<IQMixer> m_mark_mixer;
     ConfigRef<IQMixer> m_space_mixer;
     ConfigRef<Normalizer> m_mark_normalizer;
     ConfigRef<Normalizer> m_space_normalizer;
     ConfigRef<MovingAverageBase> m_mark_filter;
     ConfigRef<MovingAverageBase> m_space_filter;
-    ConfigRef<BitConverter> m_converter;
-    BitBuffer<Util::PushSequence::LsbPushedFirst, 7> m_input_buffer;
-    Ui::TextDisplay* m_text_box { nullptr };
-    Ui::XYScope* m_scope { nullptr };
-    CallbackManager m_callback_manager;
+    RttyProtocol::BaudotDecoder m_baudot_decoder;
 };
 
 }
@@ -0,0 +1,144 @@
+/*
+BSD 2-Clause License
+
+Copyright (c) 2020, Till Mayer
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "RttyUi.hpp"
+#include <FL/Fl_Box.H>
+#include <FL/Fl_Button.H>
+#include <FL/Fl_Check_Button.H>
+#include <FL/Fl_Group.H>
+#include <FL/Fl_Spinner.H>
+#include <util/Cmplx.hpp>
+
+using namespace Dsp;
+
+/* The scope input rotates by a fixed step per sample, so the rotation is looked up */
+static constexpr u8 scope_phase_count { 7 };
+static const std::array<Cmplx, scope_phase_count> s_scope_rotation = [] {
+    std::array<Cmplx, scope_phase_count> rotation;
+    for (size_t i = 0; i < rotation.size(); ++i) {
+        const float phase = Util::two_pi_f * static_cast<float>(i) / static_cast<float>(rotation.size());
+        rotation[i] = Cmplx(cosf(phase), sinf(phase));
+    }
+    return rotation;
+}();
+
+void RttyUi::update_scope(float mark, float space) {
+    if (m_scope->visible()) {
+        const Cmplx& rotation = s_scope_rotation[m_scope_phase];
+        m_scope_phase = (m_scope_phase + 1) % scope_phase_count;
+        m_scope->process(Cmplx(mark * rotation.real(), space * rotation.imag()));
+    }
+}
+
+Fl_Widget* RttyUi::build_ui(Util::Point top_left, Util::Size size) {
+    m_callback_manager.forget_callbacks();
+
+    auto* root = new Fl_Group(top_left.x(), top_left.y(), size.w(), size.h());
+    auto* controls = new Fl_Group(top_left.x(), top_left.y(), size.w(), 70);
+    controls->box(FL_EMBOSSED_BOX);
+    auto control_offset = top_left.translated(4, 4);
+    Size control_size(size.w() - 8, controls->h() - 8);
+
+    auto* shift = new Fl_Spinner(control_offset.x() + 75, control_offset.y(), 100, 30, "Shift:");
+    shift->value(m_settings.shift);
+    shift->step(1);
+    shift->range(0, 2000);
+    m_callback_manager.register_callback(*shift, [&, shift]() {
+        m_settings.shift = static_cast<float>(shift->value());
+        update_mixers();
+        update_marker();
+    });
+
+    auto* baud_rate = new Fl_Spinner(shift->x(), shift->y() + shift->h() + 2, shift->w(), 30, "Baudrate:");
+    baud_rate->value(m_settings.baud_rate);
+    baud_rate->step(.01);
+    baud_rate->range(10, 300);
+    m_callback_manager.register_callback(*baud_rate, [&, baud_rate]() {
+        m_settings.baud_rate = static_cast<float>(baud_rate->value());
+        update_marker();
+        update_filters();
+    });
+
+    auto* mark_space_swap = new Fl_Check_Button(shift->x() + shift->w() + 6,
+                                                shift->y(),
+                                                175,
+                                                30,
+                                                "Swap mark and space");
+    mark_space_swap->value(m_settings.swap_mark_and_space);
+    m_callback_manager.register_callback(*mark_space_swap, [&, mark_space_swap]() {
+        m_settings.swap_mark_and_space = static_cast<bool>(mark_space_swap->value());
+        m_clock_recovery->set_inverted(m_settings.swap_mark_and_space);
+    });
+
+    auto* show_scope = new Fl_Check_Button(mark_space_swap->x(),
+                                           mark_space_swap->y() + mark_space_swap->h() + 2,
+                                           170,
+                                           30,
+                                           "Show tuning scope");
+    m_callback_manager.register_callback(*show_scope, [&, show_scope]() {
+        if (show_scope->value())
+            m_scope->show();
+        else
+            m_scope->hide();
+        m_settings.show_tuning = static_cast<bool>(show_scope->value());
+    });
+    show_scope->value(m_settings.show_tuning);
+
+    auto* clear_button = new Fl_Button(control_offset.x() + control_size.w() - 60,
+                                       control_offset.y() + Util::center(control_size.h(), 30),
+                                       60,
+                                       30,
+                                       "Clear");
+    m_callback_manager.register_callback(*clear_button, [&]() {
+        m_text_box->clear();
+    });
+
+    m_scope = new Ui::XYScope(mark_space_swap->x() + mark_space_swap->w() + 4,
+                              control_offset.y() + Util::center(control_size.h(), 60),
+                              60,
+                              200 / decimation,
+                              .90f,
+                              true);
+    if (!m_settings.show_tuning)
+        m_scope->hide();
+
+    auto* spring = new Fl_Box(clear_button->x(), clear_button->y(), 0, 0);
+    controls->resizable(spring);
+    controls->end();
+
+    top_left.translate(0, controls->h() + 2);
+    size.resize(0, -controls->h() - 2);
+
+    m_text_box = new Ui::TextDisplay(top_left.x(), top_left.y(), size.w(), size.h());
+    root->resizable(m_text_box);
+    root->end();
+    return root;
+}
+
+void RttyUi::show_text(const char* text) {
+    m_text_box->append(text);
+}
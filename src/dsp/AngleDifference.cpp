@@ -26,7 +26,6 @@ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 #include "AngleDifference.hpp"
-#include <FL/fl_draw.H>
 #include <cmath>
 #include <util/Cmplx.hpp>
 
@@ -60,8 +59,8 @@ float AngleDifference::process(Cmplx sample) {
     return sign * abs_diff;
 }
 
-void AngleDifference::draw_at(Point p) {
-    fl_rect(p.x(), p.y(), size.w(), size.h());
+void AngleDifference::draw_at(Painter& painter, Point p) {
+    painter.rect(p.x(), p.y(), size.w(), size.h());
     p.translate(5, 5);
 
     auto width = size.w() - 11;
@@ -69,7 +68,7 @@ void AngleDifference::draw_at(Point p) {
     auto center_x = static_cast<unsigned>(std::sqrt(width * width * .49) / 2);
     auto center_y = static_cast<unsigned>(std::sqrt(height * height * .49) / 2);
 
-    fl_line(p.x(), p.y() + height, p.x() + width, p.y());
-    fl_line(p.x(), p.y() + height, p.x() + width, p.y() + height);
-    fl_line(p.x() + center_x, p.y() + height - center_y, p.x() + static_cast<unsigned>(.7 * width), p.y() + height);
+    painter.line(p.x(), p.y() + height, p.x() + width, p.y());
+    painter.line(p.x(), p.y() + height, p.x() + width, p.y() + height);
+    painter.line(p.x() + center_x, p.y() + height - center_y, p.x() + static_cast<unsigned>(.7 * width), p.y() + height);
 }
@@ -38,7 +38,7 @@ public:
     virtual Size calculate_size() override;
 
 protected:
-    virtual void draw_at(Point) override;
+    virtual void draw_at(Painter&, Point) override;
     virtual float process(Cmplx) override;
 
 private:
@@ -27,10 +27,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 #pragma once
 
-#include <FL/fl_draw.H>
 #include <dsp/Biquad.hpp>
 #include <pipe/Component.hpp>
-#include <ui/BiquadFilterDialog.hpp>
 
 namespace Dsp::Biquad {
 
@@ -78,7 +76,8 @@ public:
         m_filter.set_parameter(m_parameter);
         m_filter.set_sample_rate(this->input_sample_rate());
         m_filter.recalculate_coefficients();
-        Ui::BiquadFilterDialog::update_dialog();
+        if (auto* ui = Drtd::user_interface())
+            ui->update_config_dialog(*this);
     }
 
 protected:
@@ -92,8 +91,8 @@ protected:
         return input_sample_rate;
     }
 
-    virtual void draw_at(Point p) override {
-        fl_rect(p.x(), p.y(), size.w(), size.h());
+    virtual void draw_at(Painter& painter, Point p) override {
+        painter.rect(p.x(), p.y(), size.w(), size.h());
         p.translate(4, 4);
 
         auto inner_size = size;
@@ -105,50 +104,51 @@ protected:
         const unsigned two_thirds_width = 2 * one_third_width;
         const unsigned half_width = inner_size.w() / 2;
 
-        fl_push_matrix();
-        fl_translate(p.x(), p.y());
-        fl_begin_line();
+        painter.push_matrix();
+        painter.translate(p.x(), p.y());
+        painter.begin_line();
 
         switch (m_filter.type()) {
         case Type::Lowpass:
-            fl_vertex(0, 0);
-            fl_vertex(two_thirds_width, 0);
-            fl_vertex(three_quarters_width, inner_size.h());
+            painter.vertex(0, 0);
+            painter.vertex(two_thirds_width, 0);
+            painter.vertex(three_quarters_width, inner_size.h());
             break;
         case Type::Highpass:
-            fl_vertex(one_quarter_width, inner_size.h());
-            fl_vertex(one_third_width, 0);
-            fl_vertex(inner_size.w(), 0);
+            painter.vertex(one_quarter_width, inner_size.h());
+            painter.vertex(one_third_width, 0);
+            painter.vertex(inner_size.w(), 0);
             break;
         case Type::BandpassPeak:
-            fl_line(p.x(), p.y(), p.x() + inner_size.w(), p.y());
-            fl_vertex(one_third_width, inner_size.h());
-            fl_vertex(half_width, 0);
-            fl_vertex(two_thirds_width, inner_size.h());
+            painter.line(p.x(), p.y(), p.x() + inner_size.w(), p.y());
+            painter.vertex(one_third_width, inner_size.h());
+            painter.vertex(half_width, 0);
+            painter.vertex(two_thirds_width, inner_size.h());
             break;
         case Type::BandpassSkirt:
-            fl_line(p.x(), p.y() + 10, p.x() + inner_size.w(), p.y() + 10);
-            fl_vertex(one_third_width, inner_size.h());
-            fl_vertex(half_width, 0);
-            fl_vertex(two_thirds_width, inner_size.h());
+            painter.line(p.x(), p.y() + 10, p.x() + inner_size.w(), p.y() + 10);
+            painter.vertex(one_third_width, inner_size.h());
+            painter.vertex(half_width, 0);
+            painter.vertex(two_thirds_width, inner_size.h());
             break;
         case Type::Notch:
-            fl_vertex(0, 0);
-            fl_vertex(one_third_width, 0);
-            fl_vertex(half_width, inner_size.h());
-            fl_vertex(two_thirds_width, 0);
-            fl_vertex(inner_size.w(), 0);
+            painter.vertex(0, 0);
+            painter.vertex(one_third_width, 0);
+            painter.vertex(half_width, inner_size.h());
+            painter.vertex(two_thirds_width, 0);
+            painter.vertex(inner_size.w(), 0);
             break;
         default:
             assert(false);
         }
 
-        fl_end_line();
-        fl_pop_matrix();
+        painter.end_line();
+        painter.pop_matrix();
     }
 
     virtual void show_config_dialog() override {
-        Ui::BiquadFilterDialog::show_dialog(this->make_ref());
+        if (auto* ui = Drtd::user_interface())
+            ui->show_config_dialog(this->make_ref());
     }
 
     virtual T process(T sample) override {
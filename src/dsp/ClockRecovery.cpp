@@ -0,0 +1,163 @@
+/*
+BSD 2-Clause License
+
+Copyright (c) 2020, Till Mayer
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "ClockRecovery.hpp"
+#include <algorithm>
+#include <cmath>
+
+static constexpr const char* clockrecovery_xpm[] {
+    "40 30 2 1",
+    " 	c None",
+    ".	c #000000",
+    "........................................",
+    ".                                      .",
+    ".                                      .",
+    ".                                      .",
+    ".                                      .",
+    ".                                      .",
+    ".     ....                    ....     .",
+    ".        .                    .        .",
+    ".        .         ..         .        .",
+    ".        .        .  .        .        .",
+    ".        .        .  .        .        .",
+    ".        .        .  .        .        .",
+    ".        .         ..         .        .",
+    ".        .   .            .   .        .",
+    ".        .  .              .  .        .",
+    ".        . .................. .        .",
+    ".        .  .              .  .        .",
+    ".        .   .            .   .        .",
+    ".        .                    .        .",
+    ".        .                    .        .",
+    ".        .                    .        .",
+    ".        .                    .        .",
+    ".        .                    .        .",
+    ".        ......................        .",
+    ".                                      .",
+    ".                                      .",
+    ".                                      .",
+    ".                                      .",
+    ".                                      .",
+    "........................................"
+};
+
+using namespace Dsp;
+
+ClockRecovery::ClockRecovery(float baud_rate, bool inverted, float threshold, u8 character_bits)
+    : RefableComponent<float, BitStream, ClockRecovery>("Clock recovery")
+    , m_baud_rate(baud_rate)
+    , m_inverted(inverted)
+    , m_threshold(threshold)
+    , m_character_bits(character_bits) {
+}
+
+SampleRate ClockRecovery::on_init(SampleRate sample_rate, int&) {
+    reset();
+    return sample_rate;
+}
+
+void ClockRecovery::set_baud_rate(float baud_rate) {
+    assert(baud_rate > 0);
+    m_baud_rate = baud_rate;
+    reset();
+}
+
+void ClockRecovery::reset() {
+    m_nominal_step = m_baud_rate / input_sample_rate();
+    m_step = m_nominal_step;
+    m_phase = 0;
+    m_last_value = 0;
+    m_bits_left = 0;
+    m_bits_per_stream = static_cast<u8>(std::clamp(m_baud_rate * max_latency_seconds, 1.f, static_cast<float>(BitStream::capacity)));
+    m_collecting = {};
+}
+
+ClockRecovery& ClockRecovery::ref() {
+    return *this;
+}
+
+Size ClockRecovery::calculate_size() {
+    return Painter::pixmap_size(clockrecovery_xpm);
+}
+
+void ClockRecovery::draw_at(Painter& painter, Point p) {
+    painter.pixmap(clockrecovery_xpm, p.x(), p.y());
+}
+
+BitStream ClockRecovery::process(float sample) {
+    /* The phase counts symbols, a bit is sliced whenever it wraps, so transitions belong at half a symbol */
+    const float value = sample - m_threshold;
+    const float previous_phase = m_phase;
+    m_phase += m_step;
+
+    if ((value > 0) != (m_last_value > 0) && value != m_last_value) {
+        /* How far between the last and this sample the value crossed the threshold */
+        const float fraction = m_last_value / (m_last_value - value);
+        if (m_character_bits) {
+            /* The middle of the start bit is half a symbol after its edge */
+            if (!m_bits_left && (value > 0) == m_inverted) {
+                m_phase = .5f + m_step * (1 - fraction);
+                m_bits_left = m_character_bits;
+            }
+        } else {
+            float crossing = previous_phase + m_step * fraction;
+            crossing -= std::floor(crossing);
+
+            const float error = crossing - .5f;
+            m_phase -= phase_gain * error;
+            m_step = std::clamp(m_step - rate_gain * error * m_nominal_step,
+                                m_nominal_step * (1 - max_rate_deviation),
+                                m_nominal_step * (1 + max_rate_deviation));
+        }
+    }
+
+    m_last_value = value;
+    if (m_phase < 1) {
+        GenericComponent::abort_processing();
+        return {};
+    }
+
+    m_phase -= 1;
+    const bool bit = (value > 0) != m_inverted;
+    if (m_bits_left) {
+        /* A start bit that is gone by its middle was only noise */
+        if (m_bits_left == m_character_bits && bit)
+            m_bits_left = 0;
+        else
+            --m_bits_left;
+    }
+
+    m_collecting.append(bit, 1);
+    if (m_collecting.count < m_bits_per_stream) {
+        GenericComponent::abort_processing();
+        return {};
+    }
+
+    const BitStream stream = m_collecting;
+    m_collecting = {};
+    return stream;
+}
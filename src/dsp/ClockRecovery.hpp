@@ -0,0 +1,84 @@
+/*
+BSD 2-Clause License
+
+Copyright (c) 2020, Till Mayer
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#pragma once
+
+#include <pipe/Component.hpp>
+#include <util/BitStream.hpp>
+
+namespace Dsp {
+
+/*
+ * Recovers the symbol clock from the zero crossings of a soft value (the output of a matched filter), and
+ * slices one bit in the middle of every symbol. A bit is set if the value is above the threshold, or below
+ * it if inverted.
+ *
+ * Start-stop framed characters (character_bits > 0) shift the symbol grid whenever the stop bits are not a
+ * whole number of symbols long. Like a UART, the clock is then set at the falling edge of every start bit
+ * instead, and runs freely for the character_bits bits from the start bit up to the first stop bit.
+ */
+class ClockRecovery final : public RefableComponent<float, BitStream, ClockRecovery> {
+public:
+    ClockRecovery(float baud_rate, bool inverted = false, float threshold = 0, u8 character_bits = 0);
+
+    void set_baud_rate(float);
+    float baud_rate() const { return m_baud_rate; }
+    void set_inverted(bool inverted) { m_inverted = inverted; }
+    virtual Size calculate_size() override;
+
+protected:
+    virtual ClockRecovery& ref() override;
+    virtual void draw_at(Painter&, Point) override;
+    virtual BitStream process(float) override;
+    virtual u16 on_init(u16, int&) override;
+
+private:
+    /* Bits are handed on in batches, but never later than this after they were received */
+    static constexpr float max_latency_seconds { .05f };
+    /* How much of the timing error seen at a zero crossing is corrected in the phase and in the rate */
+    static constexpr float phase_gain { .1f };
+    static constexpr float rate_gain { .001f };
+    /* How far the symbol rate may drift from the nominal baud rate */
+    static constexpr float max_rate_deviation { .02f };
+
+    void reset();
+
+    float m_baud_rate;
+    bool m_inverted;
+    float m_threshold;
+    float m_nominal_step { 0 };
+    float m_step { 0 };
+    float m_phase { 0 };
+    float m_last_value { 0 };
+    u8 m_character_bits;
+    /* Bits still to slice of the current character, 0 while waiting for a start bit */
+    u8 m_bits_left { 0 };
+    u8 m_bits_per_stream { 1 };
+    BitStream m_collecting;
+};
+
+}
@@ -0,0 +1,82 @@
+/*
+BSD 2-Clause License
+
+Copyright (c) 2020, Till Mayer
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#pragma once
+
+#include <pipe/Component.hpp>
+#include <util/Types.hpp>
+
+namespace Dsp {
+
+/* Keeps every nth sample. There is no filter, so the input must already be band limited */
+template<typename T>
+class Decimator final : public ComponentBase<T, T> {
+public:
+    Decimator(u16 factor)
+        : ComponentBase<T, T>("Decimator")
+        , m_factor(factor) {
+        assert(factor > 0);
+    }
+
+    virtual Size calculate_size() override {
+        return size;
+    }
+
+    u16 factor() const { return m_factor; }
+
+protected:
+    virtual SampleRate on_init(SampleRate input_sample_rate, int&) override {
+        m_index = 0;
+        return input_sample_rate / m_factor;
+    }
+
+    virtual void draw_at(Painter& painter, Point p) override {
+        painter.rect(p.x(), p.y(), size.w(), size.h());
+        const int center = p.x() + size.w() / 2;
+        painter.line(center, p.y() + 3, center, p.y() + size.h() - 4);
+        painter.line(center - 4, p.y() + size.h() - 8, center, p.y() + size.h() - 4);
+        painter.line(center + 4, p.y() + size.h() - 8, center, p.y() + size.h() - 4);
+    }
+
+    virtual T process(T sample) override {
+        if (++m_index < m_factor) {
+            Pipe::GenericComponent::abort_processing();
+            return {};
+        }
+
+        m_index = 0;
+        return sample;
+    }
+
+private:
+    static constexpr Size size { 16, 20 };
+
+    u16 m_factor;
+    u16 m_index { 0 };
+};
+
+}
@@ -29,7 +29,6 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <dsp/Window.hpp>
 #include <pipe/Component.hpp>
-#include <ui/FirFilterDialog.hpp>
 #include <util/RingBuffer.hpp>
 #include <util/Types.hpp>
 
@@ -97,40 +96,41 @@ protected:
         return input_sample_rate;
     }
 
-    static void draw_sine(const Point& p, bool strikethrough, u8 index) {
+    static void draw_sine(Painter& painter, const Point& p, bool strikethrough, u8 index) {
         constexpr auto width = size.w() * .7f;
         constexpr auto height = size.h() * .7f;
         constexpr float sin_height = height / 6;
         const auto y_offset = static_cast<float>(p.y() + Util::center(size.h(), static_cast<unsigned>(height))) + 2 * sin_height * index + sin_height;
         const auto x_offset = p.x() + Util::center(size.w(), static_cast<unsigned>(width));
 
-        fl_begin_line();
-        fl_vertex(x_offset, y_offset);
+        painter.begin_line();
+        painter.vertex(x_offset, y_offset);
         for (float xi = 1; xi < width; ++xi) {
             float yi = sin_height * sinf(2 * static_cast<float>(M_PI) * (xi / width)) + y_offset;
-            fl_vertex(xi + static_cast<float>(x_offset), yi);
+            painter.vertex(xi + static_cast<float>(x_offset), yi);
         }
-        fl_end_line();
+        painter.end_line();
 
         if (strikethrough)
-            fl_line(p.x() + size.w() / 2 - 2, static_cast<int>(y_offset) - 2, p.x() + size.w() / 2 + 2, static_cast<int>(y_offset) + 2);
+            painter.line(p.x() + size.w() / 2 - 2, static_cast<int>(y_offset) - 2, p.x() + size.w() / 2 + 2, static_cast<int>(y_offset) + 2);
     }
 
-    virtual void draw_at(Point p) override {
+    virtual void draw_at(Painter& painter, Point p) override {
         unsigned mid_range_lo = this->input_sample_rate() / 6;
         unsigned mid_range_hi = this->input_sample_rate() / 3;
         bool remove_low = (start_frequency() > mid_range_lo) ^ is_band_stop();
         bool remove_mid = (start_frequency() > mid_range_hi || stop_frequency() < mid_range_lo) ^ is_band_stop();
         bool remove_high = (stop_frequency() < mid_range_hi) ^ is_band_stop();
 
-        fl_rect(p.x(), p.y(), size.w(), size.h());
-        draw_sine(p, remove_high, 0);
-        draw_sine(p, remove_mid, 1);
-        draw_sine(p, remove_low, 2);
+        painter.rect(p.x(), p.y(), size.w(), size.h());
+        draw_sine(painter, p, remove_high, 0);
+        draw_sine(painter, p, remove_mid, 1);
+        draw_sine(painter, p, remove_low, 2);
     }
 
     virtual void show_config_dialog() override {
-        Ui::FirFilterDialog::show_dialog(this->make_ref());
+        if (auto* ui = Drtd::user_interface())
+            ui->show_config_dialog(this->make_ref());
     }
 
     virtual T process(T sample) override {
@@ -43,7 +43,8 @@ FirFilterBase::FirFilterBase(FirFilterProperties properties)
 void FirFilterBase::set_properties(FirFilterProperties properties) {
     m_properties = properties;
     recalculate_coefficients();
-    Ui::FirFilterDialog::update_dialog();
+    if (auto* ui = Drtd::user_interface())
+        ui->update_config_dialog(*this);
 }
 
 void FirFilterBase::recalculate_coefficients() {
@@ -26,7 +26,6 @@ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 #include "GoertzelFilter.hpp"
-#include <FL/fl_draw.H>
 #include <cmath>
 
 using namespace Dsp;
@@ -76,12 +75,9 @@ float GoertzelFilter::process(float sample) {
 }
 
 Size GoertzelFilter::calculate_size() {
-    int width = 0;
-    int height = 0;
-    fl_measure_pixmap(goertzelfilter_xpm, width, height);
-    return { static_cast<unsigned>(width), static_cast<unsigned>(height) };
+    return Painter::pixmap_size(goertzelfilter_xpm);
 }
 
-void GoertzelFilter::draw_at(Point p) {
-    fl_draw_pixmap(goertzelfilter_xpm, p.x(), p.y());
+void GoertzelFilter::draw_at(Painter& painter, Point p) {
+    painter.pixmap(goertzelfilter_xpm, p.x(), p.y());
 }
@@ -35,7 +35,7 @@ public:
     GoertzelFilter(Taps taps, float frequency);
 
     virtual Size calculate_size() override;
-    virtual void draw_at(Point) override;
+    virtual void draw_at(Painter&, Point) override;
 
 protected:
     virtual SampleRate on_init(SampleRate, int&) override;
@@ -26,9 +26,7 @@ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 #include "IQMixer.hpp"
-#include <FL/fl_draw.H>
 #include <cmath>
-#include <ui/IQMixerDialog.hpp>
 #include <util/Cmplx.hpp>
 
 using namespace Dsp;
@@ -56,7 +54,8 @@ void IQMixer::set_frequency(Hertz frequency) {
 
     m_frequency = frequency;
     m_phase_step = Util::two_pi_f / input_sample_rate() * static_cast<float>(m_frequency);
-    Ui::IQMixerDialog::update_dialog();
+    if (auto* ui = Drtd::user_interface())
+        ui->update_config_dialog(*this);
 }
 
 SampleRate IQMixer::on_init(SampleRate input_sample_rate, int&) {
@@ -65,18 +64,19 @@ SampleRate IQMixer::on_init(SampleRate input_sample_rate, int&) {
 }
 
 void IQMixer::show_config_dialog() {
-    Ui::IQMixerDialog::show_dialog(make_ref());
+    if (auto* ui = Drtd::user_interface())
+        ui->show_config_dialog(make_ref());
 }
 
-void IQMixer::draw_at(Point p) {
-    fl_circle(p.x() + size.w() / 2, p.y() + size.h() / 2, icon_radius);
+void IQMixer::draw_at(Painter& painter, Point p) {
+    painter.circle(p.x() + size.w() / 2, p.y() + size.h() / 2, icon_radius);
     const unsigned corner_from_center = static_cast<unsigned>(std::roundf(std::sqrt(icon_radius * icon_radius / 2.f)));
 
     p.translate(icon_radius, icon_radius);
-    fl_line(p.x(), p.y(), p.x() + corner_from_center, p.y() + corner_from_center);
-    fl_line(p.x(), p.y(), p.x() + corner_from_center, p.y() - corner_from_center);
-    fl_line(p.x(), p.y(), p.x() - corner_from_center, p.y() + corner_from_center);
-    fl_line(p.x(), p.y(), p.x() - corner_from_center, p.y() - corner_from_center);
+    painter.line(p.x(), p.y(), p.x() + corner_from_center, p.y() + corner_from_center);
+    painter.line(p.x(), p.y(), p.x() + corner_from_center, p.y() - corner_from_center);
+    painter.line(p.x(), p.y(), p.x() - corner_from_center, p.y() + corner_from_center);
+    painter.line(p.x(), p.y(), p.x() - corner_from_center, p.y() - corner_from_center);
 }
 
 Cmplx IQMixer::process(float sample) {
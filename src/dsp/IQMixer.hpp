@@ -42,7 +42,7 @@ public:
 
 protected:
     virtual IQMixer& ref() override;
-    virtual void draw_at(Point) override;
+    virtual void draw_at(Painter&, Point) override;
     virtual Cmplx process(float) override;
     virtual SampleRate on_init(SampleRate, int&) override;
     virtual void show_config_dialog() override;
@@ -27,7 +27,6 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 #pragma once
 
-#include <FL/fl_draw.H>
 #include <functional>
 #include <pipe/Component.hpp>
 
@@ -46,8 +45,8 @@ public:
     }
 
 protected:
-    virtual void draw_at(Point p) override {
-        fl_rect(p.x(), p.y(), size.w(), size.h());
+    virtual void draw_at(Painter& painter, Point p) override {
+        painter.rect(p.x(), p.y(), size.w(), size.h());
         p.translate(3, 3);
         auto resized = size;
         resized.resize(-7, -7);
@@ -55,14 +54,14 @@ protected:
         const unsigned position = static_cast<unsigned>(resized.w() * .7);
 
         for (int i = 0; i < 3; ++i) {
-            fl_line(position - i + p.x(), p.y(), resized.w() - i + p.x(), resized.h() / 2 + p.y());
-            fl_line(position - i + p.x(), resized.h() + p.y(), resized.w() - i + p.x(), resized.h() / 2 + p.y() + 1);
+            painter.line(position - i + p.x(), p.y(), resized.w() - i + p.x(), resized.h() / 2 + p.y());
+            painter.line(position - i + p.x(), resized.h() + p.y(), resized.w() - i + p.x(), resized.h() / 2 + p.y() + 1);
         }
 
-        fl_line(p.x(), resized.h() / 2 + p.y(), resized.w() + p.x(), resized.h() / 2 + p.y());
-        fl_line(p.x(), resized.h() / 2 + p.y() + 1, resized.w() + p.x(), resized.h() / 2 + 1 + p.y());
-        fl_line(p.x(), p.y(), p.x(), resized.h() + p.y());
-        fl_line(p.x() + 1, p.y(), p.x() + 1, resized.h() + p.y());
+        painter.line(p.x(), resized.h() / 2 + p.y(), resized.w() + p.x(), resized.h() / 2 + p.y());
+        painter.line(p.x(), resized.h() / 2 + p.y() + 1, resized.w() + p.x(), resized.h() / 2 + 1 + p.y());
+        painter.line(p.x(), p.y(), p.x(), resized.h() + p.y());
+        painter.line(p.x() + 1, p.y(), p.x() + 1, resized.h() + p.y());
     }
 
     virtual Out process(In in) override {
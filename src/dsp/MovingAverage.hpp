@@ -27,9 +27,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 #pragma once
 
-#include <FL/fl_draw.H>
 #include <pipe/Component.hpp>
-#include <ui/MovingAverageDialog.hpp>
 #include <util/RingBuffer.hpp>
 #include <util/Types.hpp>
 
@@ -58,11 +56,7 @@ public:
     }
 
     virtual Size calculate_size() override {
-        int width = 0;
-        int height = 0;
-
-        fl_measure_pixmap(moving_average_xpm, width, height);
-        return { static_cast<unsigned>(width), static_cast<unsigned>(height) };
+        return Painter::pixmap_size(moving_average_xpm);
     }
 
     virtual void set_taps(Taps taps) override {
@@ -73,7 +67,8 @@ public:
         m_buffer.resize(m_taps);
         m_average = 0;
         m_zero_count = 0;
-        Ui::MovingAverageDialog::update_dialog();
+        if (auto* ui = Drtd::user_interface())
+            ui->update_config_dialog(*this);
     }
 
     virtual Taps taps() const override {
@@ -90,12 +85,13 @@ protected:
         return *this;
     }
 
-    virtual void draw_at(Point p) override {
-        fl_draw_pixmap(moving_average_xpm, p.x(), p.y());
+    virtual void draw_at(Painter& painter, Point p) override {
+        painter.pixmap(moving_average_xpm, p.x(), p.y());
     }
 
     virtual void show_config_dialog() override {
-        Ui::MovingAverageDialog::show_dialog(this->make_ref());
+        if (auto* ui = Drtd::user_interface())
+            ui->show_config_dialog(this->make_ref());
     }
 
     virtual T process(T sample) override {
@@ -26,7 +26,6 @@ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 #include "NRZIDecoder.hpp"
-#include <FL/fl_draw.H>
 
 static constexpr const char* nrzidecoder_xpm[] {
     "30 26 2 1",
@@ -63,23 +62,25 @@ static constexpr const char* nrzidecoder_xpm[] {
 using namespace Dsp;
 
 NRZIDecoder::NRZIDecoder(bool inverted)
-    : ComponentBase<bool, bool>("NRZI Decoder")
+    : ComponentBase<BitStream, BitStream>("NRZI Decoder")
     , m_inverted(inverted) {
 }
 
 Size NRZIDecoder::calculate_size() {
-    int width = 0;
-    int height = 0;
-    fl_measure_pixmap(nrzidecoder_xpm, width, height);
-    return { static_cast<unsigned>(width), static_cast<unsigned>(height) };
+    return Painter::pixmap_size(nrzidecoder_xpm);
 }
 
-void NRZIDecoder::draw_at(Point p) {
-    fl_draw_pixmap(nrzidecoder_xpm, p.x(), p.y());
+void NRZIDecoder::draw_at(Painter& painter, Point p) {
+    painter.pixmap(nrzidecoder_xpm, p.x(), p.y());
 }
 
-bool NRZIDecoder::process(bool sample) {
-    bool ret = (sample == m_last_sample) == m_inverted;
-    m_last_sample = sample;
-    return ret;
+BitStream NRZIDecoder::process(BitStream stream) {
+    if (stream.empty())
+        return stream;
+
+    /* A bit is set where the level changed compared to the bit before it */
+    const u64 changed = stream.bits ^ ((stream.bits << 1) | m_last_sample);
+    m_last_sample = stream.newest();
+    stream.bits = (m_inverted ? ~changed : changed) & BitStream::mask(stream.count);
+    return stream;
 }
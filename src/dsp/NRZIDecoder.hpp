@@ -28,17 +28,18 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #pragma once
 
 #include <pipe/Component.hpp>
+#include <util/BitStream.hpp>
 
 namespace Dsp {
 
-class NRZIDecoder final : public ComponentBase<bool, bool> {
+class NRZIDecoder final : public ComponentBase<BitStream, BitStream> {
 public:
     NRZIDecoder(bool inverted);
     virtual Size calculate_size() override;
 
 protected:
-    virtual void draw_at(Point) override;
-    virtual bool process(bool) override;
+    virtual void draw_at(Painter&, Point) override;
+    virtual BitStream process(BitStream) override;
 
 private:
     bool m_inverted;
@@ -68,15 +68,11 @@ Normalizer::Normalizer(WindowSize window_size, Lookahead lookahead, OffsetMode o
 }
 
 Size Normalizer::calculate_size() {
-    int width = 0;
-    int height = 0;
-
-    fl_measure_pixmap(normalizer_xpm, width, height);
-    return { static_cast<unsigned>(width), static_cast<unsigned>(height) };
+    return Painter::pixmap_size(normalizer_xpm);
 }
 
-void Normalizer::draw_at(Point p) {
-    fl_draw_pixmap(normalizer_xpm, p.x(), p.y());
+void Normalizer::draw_at(Painter& painter, Point p) {
+    painter.pixmap(normalizer_xpm, p.x(), p.y());
 }
 
 float Dsp::Normalizer::process(float sample) {
@@ -27,7 +27,6 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 #pragma once
 
-#include <FL/fl_draw.H>
 #include <cmath>
 #include <limits>
 #include <pipe/Component.hpp>
@@ -57,7 +56,7 @@ public:
 
 protected:
     virtual Normalizer& ref() override { return *this; }
-    virtual void draw_at(Point) override;
+    virtual void draw_at(Painter&, Point) override;
     virtual float process(float) override;
 
 private:
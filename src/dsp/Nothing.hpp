@@ -27,7 +27,6 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 #pragma once
 
-#include <FL/fl_draw.H>
 #include <decoder/Decoder.hpp>
 #include <pipe/Component.hpp>
 #include <thread>
@@ -46,10 +45,10 @@ public:
     }
 
 protected:
-    virtual void draw_at(Point p) override {
-        fl_rect(p.x(), p.y(), size.w(), size.h());
-        fl_line(p.x(), p.y() + 3, p.x() + 14, p.y() + 3);
-        fl_line(p.x(), p.y() + 4, p.x() + 14, p.y() + 4);
+    virtual void draw_at(Painter& painter, Point p) override {
+        painter.rect(p.x(), p.y(), size.w(), size.h());
+        painter.line(p.x(), p.y() + 3, p.x() + 14, p.y() + 3);
+        painter.line(p.x(), p.y() + 4, p.x() + 14, p.y() + 4);
     }
 
     virtual T process(T t) override {
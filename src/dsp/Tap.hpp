@@ -2,7 +2,6 @@
 
 #include <pipe/Component.hpp>
 #include <functional>
-#include <FL/fl_draw.H>
 
 namespace Dsp {
 
@@ -19,11 +18,11 @@ public:
     }
 
 protected:
-    virtual void draw_at(Point p) override {
-        fl_line_style(FL_CAP_SQUARE, 2);
-        fl_line(p.x(), p.y() + 5, p.x() + 9, p.y() + 5);
-        fl_line(p.x() + 5, p.y() + 5, p.x() + 5, p.y() + 0);
-        fl_line_style(0);
+    virtual void draw_at(Painter& painter, Point p) override {
+        painter.set_line_width(2);
+        painter.line(p.x(), p.y() + 5, p.x() + 9, p.y() + 5);
+        painter.line(p.x() + 5, p.y() + 5, p.x() + 5, p.y() + 0);
+        painter.set_line_width(0);
     }
 
     virtual T process(T t) override {
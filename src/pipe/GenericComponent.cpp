@@ -27,10 +27,6 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 #include "GenericComponent.hpp"
 #include <Drtd.hpp>
-#include <FL/fl_ask.H>
-#include <FL/fl_draw.H>
-#include <ui/MainGui.hpp>
-#include <ui/component/Waterfall.hpp>
 #include <util/Logger.hpp>
 #include <util/Util.hpp>
 
@@ -72,27 +68,29 @@ void GenericComponent::set_monitor(int id, Monitor monitor, InterpreterPropertie
     s_monitor = monitor;
 }
 
-void GenericComponent::draw(Point location) {
+void GenericComponent::draw(Painter& painter, Point location) {
     m_absolute_position = location;
-    fl_color(FL_BLACK);
-    draw_at(location);
+    painter.set_color(Painter::black);
+    draw_at(painter, location);
 }
 
 bool GenericComponent::clicked_component(Point clicked_at, ClickEvent event) {
     if (Util::rect_contains(clicked_at, m_absolute_position, this->calculate_size())) {
-        auto& waterfall = Drtd::main_gui().waterfall();
-
         switch (event) {
         case ClickEvent::MonitorInput:
             monitor(Monitor::Input);
-            waterfall.set_sample_rate(input_sample_rate());
-            waterfall.show_marker(false);
+            if (auto* ui = Drtd::user_interface()) {
+                ui->set_monitor_sample_rate(input_sample_rate());
+                ui->show_marker(false);
+            }
             s_log.info() << "Now monitoring input at " << id();
             break;
         case ClickEvent::MonitorOutput:
             monitor(Monitor::Output);
-            waterfall.set_sample_rate(output_sample_rate());
-            waterfall.show_marker(false);
+            if (auto* ui = Drtd::user_interface()) {
+                ui->set_monitor_sample_rate(output_sample_rate());
+                ui->show_marker(false);
+            }
             s_log.info() << "Now monitoring output at " << id();
             break;
         case ClickEvent::Configure:
@@ -109,40 +107,41 @@ bool GenericComponent::clicked_component(Point clicked_at, ClickEvent event) {
 }
 
 void GenericComponent::show_config_dialog() {
-    fl_message("Nothing to configure for \"%s\"", name().c_str());
+    if (auto* ui = Drtd::user_interface())
+        ui->show_message("Nothing to configure for \"" + name() + '"');
 }
 
-void Pipe::draw_connecting_line_vertical(u32 from_x, u32 from_y, u32 to_y) {
-    fl_yxline(from_x, from_y, to_y);
-    fl_yxline(from_x + 1, from_y, to_y);
+void Pipe::draw_connecting_line_vertical(Painter& painter, u32 from_x, u32 from_y, u32 to_y) {
+    painter.vertical_line(from_x, from_y, to_y);
+    painter.vertical_line(from_x + 1, from_y, to_y);
 }
 
-void Pipe::draw_connecting_line_horizontal(u32 from_x, u32 from_y, u32 to_x) {
-    fl_xyline(from_x, from_y, to_x);
-    fl_xyline(from_x, from_y + 1, to_x);
+void Pipe::draw_connecting_line_horizontal(Painter& painter, u32 from_x, u32 from_y, u32 to_x) {
+    painter.horizontal_line(from_x, from_y, to_x);
+    painter.horizontal_line(from_x, from_y + 1, to_x);
 }
 
-void Pipe::draw_marker(MarkerType type, Point pointing_at) {
-    auto old_color = fl_color();
-    fl_color(FL_DARK_GREEN);
-    fl_push_matrix();
-    fl_begin_line();
+void Pipe::draw_marker(Painter& painter, MarkerType type, Point pointing_at) {
+    auto old_color = painter.color();
+    painter.set_color(Painter::dark_green);
+    painter.push_matrix();
+    painter.begin_line();
 
     if (type == MarkerType::MarkOutput) {
-        fl_translate(pointing_at.x(), pointing_at.y());
+        painter.translate(pointing_at.x(), pointing_at.y());
         for (auto& point : s_marker_monitor_output)
-            fl_vertex(point.x(), point.y());
+            painter.vertex(point.x(), point.y());
     } else if (type == MarkerType::MarkInput) {
-        fl_translate(pointing_at.x(), pointing_at.y());
+        painter.translate(pointing_at.x(), pointing_at.y());
         for (auto& point : s_marker_monitor_input)
-            fl_vertex(point.x(), point.y());
+            painter.vertex(point.x(), point.y());
     }
 
-    fl_end_line();
-    fl_pop_matrix();
-    fl_color(old_color);
+    painter.end_line();
+    painter.pop_matrix();
+    painter.set_color(old_color);
 }
 
-void Pipe::draw_simple_connector(Util::Point from, Util::Point to) {
-    draw_connecting_line_horizontal(from.x(), from.y(), to.x());
+void Pipe::draw_simple_connector(Painter& painter, Util::Point from, Util::Point to) {
+    draw_connecting_line_horizontal(painter, from.x(), from.y(), to.x());
 }
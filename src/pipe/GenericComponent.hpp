@@ -27,7 +27,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 #pragma once
 
+#include <limits>
 #include <pipe/Interpreter.hpp>
+#include <pipe/Painter.hpp>
 #include <util/Logger.hpp>
 #include <util/Point.hpp>
 #include <util/Size.hpp>
@@ -73,6 +75,9 @@ public:
         std::swap(first.m_id, second.m_id);
     }
 
+    /* Pipelines that are not shown in the UI count their ids up from here, so they are never monitored */
+    static constexpr int hidden_first_id { std::numeric_limits<int>::min() / 2 };
+
     static Monitor current_monitor() { return s_monitor; }
     static int current_monitor_id() { return s_monitor_id; }
     static bool monitoring(int id, Monitor monitor);
@@ -83,9 +88,9 @@ public:
     static void prepare_processing() { s_abort_processing = false; }
     static bool did_abort_processing() { return s_abort_processing; }
 
-    void draw(Point location);
-    void monitor(Monitor monitor) { GenericComponent::set_monitor(id(), monitor, properties(monitor)); }
+    void draw(Painter& painter, Point location);
     Util::Point absolute_position() const { return m_absolute_position; }
+    void monitor(Monitor monitor) { GenericComponent::set_monitor(id(), monitor, properties(monitor)); }
 
     const std::string& name() const { return m_name; };
     int id() const { return m_id; };
@@ -93,8 +98,8 @@ public:
     SampleRate input_sample_rate() const { return m_input_sample_rate; }
 
     virtual bool clicked_component(Point clicked_at, ClickEvent event);
-    virtual SampleRate init(SampleRate input_sample_rate, int& id_counter) = 0;
     virtual Size calculate_size() = 0;
+    virtual SampleRate init(SampleRate input_sample_rate, int& id_counter) = 0;
     virtual InterpreterProperties properties(Monitor) const = 0;
 
 protected:
@@ -102,7 +107,8 @@ protected:
     static int s_monitor_id;
     static u8 s_interpreter_index;
     static InterpreterProperties s_interpreter;
-    static inline bool s_abort_processing { false };
+    /* Pipelines of some decoders run on several threads at once */
+    static inline thread_local bool s_abort_processing { false };
 
     static void set_monitor(int id, Monitor, InterpreterProperties);
 
@@ -111,7 +117,7 @@ protected:
     void set_output_sample_rate(SampleRate output) { m_output_sample_rate = output; }
     void set_id(int id) { m_id = id; }
 
-    virtual void draw_at(Point) = 0;
+    virtual void draw_at(Painter&, Point) = 0;
     virtual void show_config_dialog();
 
 private:
@@ -137,9 +143,9 @@ enum class MarkerType {
 static constexpr u8 component_horizontal_spacing { 20 };
 static constexpr u8 component_vertical_spacing { 10 };
 
-void draw_connecting_line_vertical(u32 from_x, u32 from_y, u32 to_y);
-void draw_connecting_line_horizontal(u32 from_x, u32 from_y, u32 to_x);
-void draw_simple_connector(Point from, Point to);
-void draw_marker(MarkerType type, Point pointing_at);
+void draw_connecting_line_vertical(Painter&, u32 from_x, u32 from_y, u32 to_y);
+void draw_connecting_line_horizontal(Painter&, u32 from_x, u32 from_y, u32 to_x);
+void draw_simple_connector(Painter&, Point from, Point to);
+void draw_marker(Painter&, MarkerType type, Point pointing_at);
 
 }
@@ -26,6 +26,7 @@ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 #include "Interpreter.hpp"
+#include <util/BitStream.hpp>
 #include <util/Cmplx.hpp>
 
 using namespace Pipe;
@@ -66,3 +67,14 @@ template<>
 Interpreter<u8> Pipe::interpreter() {
     return { { .names = { "Integer" }, .color = 0x66CC6600 }, [](u8, u8& b) { return static_cast<float>(b); } };
 }
+
+template<>
+Interpreter<BitStream> Pipe::interpreter() {
+    return { { .names = { "Newest bit", "Bit count" }, .color = 0xCC4C9900 },
+             [](u8 index, BitStream& stream) {
+                 if (index == 1)
+                     return static_cast<float>(stream.count);
+
+                 return stream.empty() ? 0.f : (stream.newest() ? 1.f : 0.f);
+             } };
+}
@@ -27,7 +27,6 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 #pragma once
 
-#include <FL/Fl.H>
 #include <functional>
 #include <string>
 #include <util/Buffer.hpp>
@@ -37,7 +36,8 @@ namespace Pipe {
 
 struct InterpreterProperties {
     Buffer<std::string> names;
-    Fl_Color color;
+    /* An Fl_Color */
+    u32 color;
 };
 
 template<typename Type>
@@ -27,7 +27,6 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 #pragma once
 
-#include <FL/fl_draw.H>
 #include <pipe/Component.hpp>
 #include <pipe/ComponentContainer.hpp>
 
@@ -120,7 +119,7 @@ public:
     }
 
 protected:
-    virtual void draw_at(Util::Point position) override {
+    virtual void draw_at(Painter& painter, Util::Point position) override {
         auto size = calculate_size();
         unsigned center = size.h() / 2;
         position.translate(0, center);
@@ -130,16 +129,16 @@ protected:
             auto component_size = component.calculate_size();
 
             Point component_right = position.translated(component_size.w(), 0);
-            component.draw({ position.x(), static_cast<int>(position.y() - component_size.h() / 2) });
+            component.draw(painter, { position.x(), static_cast<int>(position.y() - component_size.h() / 2) });
 
             if (GenericComponent::monitoring(component.id(), Monitor::Input))
-                Pipe::draw_marker(MarkerType::MarkInput, position);
+                Pipe::draw_marker(painter, MarkerType::MarkInput, position);
             else if (GenericComponent::monitoring(component.id(), Monitor::Output))
-                Pipe::draw_marker(MarkerType::MarkOutput, component_right);
+                Pipe::draw_marker(painter, MarkerType::MarkOutput, component_right);
 
             if (last_component != &component) {
-                fl_color(component.properties(Monitor::Output).color);
-                Pipe::draw_simple_connector(component_right.translated(0, -1), component_right.translated(Pipe::component_horizontal_spacing - 1, -1));
+                painter.set_color(component.properties(Monitor::Output).color);
+                Pipe::draw_simple_connector(painter, component_right.translated(0, -1), component_right.translated(Pipe::component_horizontal_spacing - 1, -1));
             }
 
             position = component_right.translated(Pipe::component_horizontal_spacing, 0);
@@ -0,0 +1,72 @@
+/*
+BSD 2-Clause License
+
+Copyright (c) 2020, Till Mayer
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#pragma once
+
+#include <util/Point.hpp>
+#include <util/Size.hpp>
+#include <util/Types.hpp>
+
+namespace Pipe {
+
+/* Draws the pipeline for the user interface, components do not depend on the toolkit it uses */
+class Painter {
+public:
+    /* Colors are Fl_Color values, as in InterpreterProperties */
+    static constexpr u32 black { 56 };
+    static constexpr u32 dark_green { 60 };
+
+    virtual ~Painter() = default;
+
+    /* Reads the size from the values line of an XPM image, so components can be measured without drawing them */
+    static Size pixmap_size(const char* const* xpm);
+
+    virtual u32 color() const = 0;
+    virtual void set_color(u32 color) = 0;
+    /* Lines have square caps and are one pixel wide at a width of 0 */
+    virtual void set_line_width(int width) = 0;
+
+    virtual void line(int x, int y, int x1, int y1) = 0;
+    virtual void horizontal_line(int x, int y, int x1) = 0;
+    virtual void vertical_line(int x, int y, int y1) = 0;
+    virtual void rect(int x, int y, int width, int height) = 0;
+    virtual void circle(double x, double y, double radius) = 0;
+    virtual void polygon(int x0, int y0, int x1, int y1, int x2, int y2, int x3, int y3) = 0;
+    virtual void pixmap(const char* const* xpm, int x, int y) = 0;
+
+    /* Vertices of a line are transformed by the current matrix */
+    virtual void begin_line() = 0;
+    virtual void vertex(double x, double y) = 0;
+    virtual void end_line() = 0;
+    virtual void push_matrix() = 0;
+    virtual void translate(double x, double y) = 0;
+    virtual void pop_matrix() = 0;
+};
+
+}
+
+using Pipe::Painter;
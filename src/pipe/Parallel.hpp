@@ -27,7 +27,6 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 #pragma once
 #include "Component.hpp"
-#include <FL/fl_draw.H>
 #include <functional>
 #include <list>
 #include <pipe/ComponentContainer.hpp>
@@ -35,8 +34,23 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 namespace Pipe {
 
+/*
+ * Every line runs on every sample, even if another line aborted processing. The merge policy decides
+ * whether the merge function still gets called if only some of the lines produced an output, the
+ * outputs of the other lines are default constructed in that case.
+ */
+enum class MergePolicy : bool {
+    AllLinesProduced,
+    AnyLineProduced
+};
+
+template<typename In, typename Out>
+struct ParallelContainerBase : public Container::ComponentContainerBase<In, const Util::Buffer<Out>&> {
+    virtual size_t lines_produced() const = 0;
+};
+
 template<typename In, typename Out, typename... Lines>
-class ParallelContainer final : public Container::ComponentContainerBase<In, const Util::Buffer<Out>&> {
+class ParallelContainer final : public ParallelContainerBase<In, Out> {
 public:
     using Iterator = std::function<Util::IterationDecision(GenericComponent&)>;
     using OutputBuffer = Util::Buffer<Out>;
@@ -48,10 +62,16 @@ public:
     }
 
     virtual const OutputBuffer& run(In in) override {
+        m_lines_produced = 0;
         std::apply([&](Lines&... lines) { ParallelContainer::run(m_output_buffer, 0, in, lines...); }, m_lines);
+        GenericComponent::prepare_processing();
         return m_output_buffer;
     }
 
+    virtual size_t lines_produced() const override {
+        return m_lines_produced;
+    }
+
     virtual void for_each(Iterator callback) override {
         std::apply([&](Lines&... lines) { ParallelContainer::for_each_component(callback, lines...); }, m_lines);
     }
@@ -71,7 +91,13 @@ public:
 private:
     template<typename... Components>
     void run(OutputBuffer& buffer, size_t index, In in, ComponentBase<In, Out>& component, Components&... others) {
+        GenericComponent::prepare_processing();
         buffer[index] = component.run(in);
+        if (GenericComponent::did_abort_processing())
+            buffer[index] = {};
+        else
+            ++m_lines_produced;
+
         run(buffer, index + 1, in, others...);
     }
 
@@ -89,6 +115,7 @@ private:
 
     std::tuple<Lines...> m_lines;
     OutputBuffer m_output_buffer;
+    size_t m_lines_produced { 0 };
 };
 
 static constexpr Util::Size marker_size = { 14, 14 };
@@ -99,11 +126,12 @@ template<typename In, typename Out, typename MergeOut>
 class Parallel final : public ComponentBase<In, MergeOut> {
 public:
     using ContainerOut = const Util::Buffer<Out>&;
-    using ContainerType = Container::ComponentContainerBase<In, ContainerOut>;
-    Parallel(std::function<MergeOut(ContainerOut)> merge_function, std::unique_ptr<ContainerType> lines)
+    using ContainerType = ParallelContainerBase<In, Out>;
+    Parallel(std::function<MergeOut(ContainerOut)> merge_function, std::unique_ptr<ContainerType> lines, MergePolicy merge_policy)
         : ComponentBase<In, MergeOut>("Parallel")
         , m_merge_function(merge_function)
-        , m_lines(std::move(lines)) {
+        , m_lines(std::move(lines))
+        , m_merge_policy(merge_policy) {
     }
 
     virtual Size calculate_size() override {
@@ -145,7 +173,7 @@ public:
     }
 
 protected:
-    virtual void draw_at(Point position) override {
+    virtual void draw_at(Painter& painter, Point position) override {
         auto abs_position = position;
         position.translate(pipeline_horizontal_spacing_adjusted, 0);
 
@@ -159,7 +187,7 @@ protected:
                 marker_index = point_index;
 
             auto line_size = line.calculate_size();
-            line.draw(position);
+            line.draw(painter, position);
 
             left_points[point_index] = { position.x() - pipeline_horizontal_spacing_adjusted, static_cast<int>(position.y() + line_size.h() / 2 - 1) };
             right_points[point_index] = { static_cast<int>(position.x() + line_size.w()), static_cast<int>(position.y() + line_size.h() / 2 - 1) };
@@ -169,9 +197,9 @@ protected:
         });
 
         auto& some_line = m_lines->first();
-        fl_color(some_line.properties(Monitor::Input).color);
-        draw_opening_connectors(left_points, marker_index);
-        draw_closing_connectors(abs_position, right_points, some_line.properties(Monitor::Output).color, marker_index);
+        painter.set_color(some_line.properties(Monitor::Input).color);
+        draw_opening_connectors(painter, left_points, marker_index);
+        draw_closing_connectors(painter, abs_position, right_points, some_line.properties(Monitor::Output).color, marker_index);
     }
 
     virtual SampleRate on_init(SampleRate input_sample_rate, int& id_counter) override {
@@ -190,14 +218,17 @@ protected:
 
     MergeOut process(In in) override {
         auto& result = m_lines->run(in);
-        if (GenericComponent::did_abort_processing())
+        const auto produced = m_lines->lines_produced();
+        if (produced == 0 || (m_merge_policy == MergePolicy::AllLinesProduced && produced != m_lines->size())) {
+            GenericComponent::abort_processing();
             return {};
+        }
 
         return m_merge_function(result);
     }
 
 private:
-    void draw_opening_connectors(const Util::Buffer<Util::Point>& source_points, int marker_index) {
+    void draw_opening_connectors(Painter& painter, const Util::Buffer<Util::Point>& source_points, int marker_index) {
         u32 x_target = source_points[0].x() + pipeline_horizontal_spacing_adjusted - 1;
         auto direction = GenericComponent::current_monitor() == Monitor::Input ? MarkerType::MarkInput : MarkerType::NoMarker;
 
@@ -208,24 +239,24 @@ private:
             max_y = std::max(max_y, src.y());
         }
 
-        Pipe::draw_connecting_line_vertical(source_points[0].x(), min_y, max_y);
+        Pipe::draw_connecting_line_vertical(painter, source_points[0].x(), min_y, max_y);
         int index = 0;
         for (auto& src : source_points) {
             Point target(x_target, src.y());
             if (index == marker_index)
-                Pipe::draw_marker(direction, target);
-            Pipe::draw_simple_connector(src, target);
+                Pipe::draw_marker(painter, direction, target);
+            Pipe::draw_simple_connector(painter, src, target);
             ++index;
         }
     }
 
-    void draw_closing_connectors(const Util::Point& absolute_position, const Util::Buffer<Util::Point>& source_points, Fl_Color intermediate, int marker_index) {
+    void draw_closing_connectors(Painter& painter, const Util::Point& absolute_position, const Util::Buffer<Util::Point>& source_points, u32 intermediate, int marker_index) {
         int min_y = std::numeric_limits<int>::max();
         int max_y = std::numeric_limits<int>::min();
         auto position = GenericComponent::current_monitor() == Monitor::Output ? MarkerType::MarkOutput : MarkerType::NoMarker;
         int x_target = std::numeric_limits<int>::min();
 
-        fl_color(intermediate);
+        painter.set_color(intermediate);
         for (auto& src : source_points) {
             x_target = std::max(x_target, src.x());
             min_y = std::min(min_y, src.y());
@@ -233,33 +264,39 @@ private:
         }
         x_target += pipeline_horizontal_spacing_adjusted;
 
-        Pipe::draw_connecting_line_vertical(x_target, min_y, max_y + 1);
+        Pipe::draw_connecting_line_vertical(painter, x_target, min_y, max_y + 1);
         int index = 0;
         for (auto& src : source_points) {
             if (index == marker_index)
-                Pipe::draw_marker(position, src);
+                Pipe::draw_marker(painter, position, src);
 
-            Pipe::draw_simple_connector(src, { x_target + 1, src.y() });
+            Pipe::draw_simple_connector(painter, src, { x_target + 1, src.y() });
             ++index;
         }
 
-        fl_color(FL_BLACK);
+        painter.set_color(Painter::black);
         m_marker_location = { x_target + 1, static_cast<int>(absolute_position.y() + calculate_size().h() / 2) };
-        fl_polygon(m_marker_location.x() - 6, m_marker_location.y() + 6,
-                   m_marker_location.x() - 6, m_marker_location.y() - 7,
-                   m_marker_location.x() + 6, m_marker_location.y() - 1,
-                   m_marker_location.x() + 6, m_marker_location.y());
+        painter.polygon(m_marker_location.x() - 6, m_marker_location.y() + 6,
+                        m_marker_location.x() - 6, m_marker_location.y() - 7,
+                        m_marker_location.x() + 6, m_marker_location.y() - 1,
+                        m_marker_location.x() + 6, m_marker_location.y());
         m_marker_location.translate(-static_cast<int>(marker_size.w() / 2), -static_cast<int>(marker_size.h() / 2));
     }
 
     Util::Point m_marker_location;
     std::function<MergeOut(const Util::Buffer<Out>&)> m_merge_function;
     std::unique_ptr<ContainerType> m_lines;
+    MergePolicy m_merge_policy;
 };
 
 template<typename MergeOut, typename... Lines, typename In = typename FirstComponent<Lines...>::InputType, typename Out = typename FirstComponent<Lines...>::OutputType>
 static Parallel<In, Out, MergeOut> parallel(std::function<MergeOut(const Buffer<Out>&)> merge_func, Lines&&... lines) {
-    return Parallel<In, Out, MergeOut>(merge_func, std::make_unique<ParallelContainer<In, Out, Lines...>>(std::move(lines)...));
+    return Parallel<In, Out, MergeOut>(merge_func, std::make_unique<ParallelContainer<In, Out, Lines...>>(std::move(lines)...), MergePolicy::AllLinesProduced);
+}
+
+template<typename MergeOut, typename... Lines, typename In = typename FirstComponent<Lines...>::InputType, typename Out = typename FirstComponent<Lines...>::OutputType>
+static Parallel<In, Out, MergeOut> parallel(MergePolicy merge_policy, std::function<MergeOut(const Buffer<Out>&)> merge_func, Lines&&... lines) {
+    return Parallel<In, Out, MergeOut>(merge_func, std::make_unique<ParallelContainer<In, Out, Lines...>>(std::move(lines)...), merge_policy);
 }
 
 }
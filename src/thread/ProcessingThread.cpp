@@ -26,17 +26,13 @@ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 #include "ProcessingThread.hpp"
+#include <util/UiLock.hpp>
 
 using namespace Dsp;
 
 ProcessingLock::ProcessingLock(bool from_main_thread) {
-    if (Drtd::using_ui() && from_main_thread)
-        Fl::unlock();
-
+    Util::UiUnlock unlock(Drtd::using_ui() && from_main_thread);
     s_pipeline_mutex.lock();
-
-    if (Drtd::using_ui() && from_main_thread)
-        Fl::lock();
 }
 
 ProcessingLock::~ProcessingLock() {
@@ -61,13 +57,11 @@ bool ProcessingThread::is_running() {
 void ProcessingThread::request_stop_and_wait() {
     m_run.store(false);
     on_stop_requested();
-    if (Drtd::using_ui())
-        Fl::unlock();
-
-    join();
+    {
+        Util::UiUnlock unlock(Drtd::using_ui());
+        join();
+    }
 
-    if (Drtd::using_ui())
-        Fl::lock();
     m_running = false;
 }
 
@@ -84,17 +78,14 @@ void ProcessingThread::run() {
         while (m_run.load()) {
             if ((read = fill_buffer(buffer))) {
                 assert(read <= s_sample_buffer_size);
-                ProcessingLock lock(false); //Lock components
-                Fl::lock();                 //Lock fltk
+                ProcessingLock lock(false);
+                Util::UiLock ui_lock;
 
                 for (size_t i = 0; i < read && m_run.load(); ++i) {
                     m_resampler->process_input_sample(buffer[i]);
                     while (m_resampler->read_output_sample(sample))
                         m_decoder->process(buffer[i]);
                 }
-
-                Fl::awake();
-                Fl::unlock();
             } else if (m_run.load()) {
                 m_log.warning() << "Could not read samples!";
             }
@@ -103,14 +94,11 @@ void ProcessingThread::run() {
         while (m_run.load()) {
             if ((read = fill_buffer(buffer))) {
                 assert(read <= s_sample_buffer_size);
-                ProcessingLock lock(false); //Lock components
-                Fl::lock();                 //Lock fltk
+                ProcessingLock lock(false);
+                Util::UiLock ui_lock;
 
                 for (size_t i = 0; i < read && m_run.load(); ++i)
                     m_decoder->process(buffer[i]);
-
-                Fl::awake();
-                Fl::unlock();
             } else if (m_run.load()) {
                 m_log.warning() << "Could not read samples!";
             }
@@ -29,6 +29,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <atomic>
 #include <decoder/Decoder.hpp>
+#include <mutex>
 #include <thread>
 #include <util/Buffer.hpp>
 #include <util/Resampler.hpp>
@@ -26,6 +26,8 @@ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 #include "ConfigDialog.hpp"
+#include "MainGui.hpp"
+#include "PipelinePainter.hpp"
 #include <Drtd.hpp>
 #include <FL/fl_ask.H>
 #include <decoder/Decoder.hpp>
@@ -151,8 +153,8 @@ void ConfigDialog::update(bool reposition) {
     {
         Ui::LayerDraw draw(m_pipeline_layer);
         fl_rectf(0, 0, m_pipeline_layer->current_width(), m_pipeline_layer->current_height(), m_pipeline_layer->clear_color());
-        fl_color(FL_BLACK);
-        line.draw({ Util::center(m_pipeline_layer->current_width(), size.w()), Util::center(m_pipeline_layer->current_height(), size.h()) });
+        PipelinePainter painter;
+        line.draw(painter, { Util::center(m_pipeline_layer->current_width(), size.w()), Util::center(m_pipeline_layer->current_height(), size.h()) });
     }
 
     m_pipeline_canvas.damage(FL_DAMAGE_ALL);
@@ -104,7 +104,7 @@ void FirFilterDialog::update_dialog() {
         constexpr u16 min_fft_hz_per_bin = 10;
         auto sinc_coeffs = filter.coefficients().resized(std::max(filter.taps(), static_cast<u16>(filter.sample_rate() / min_fft_hz_per_bin)));
         Buffer<float> plot_values((sinc_coeffs.size() - 1) / 2);
-        FFT fft(sinc_coeffs.size());
+        FFT fft(sinc_coeffs.size(), FFT::Planning::Estimate);
         for (size_t i = 0; i < sinc_coeffs.size(); ++i)
             fft.input_buffer()[i] = sinc_coeffs[i];
 
@@ -112,11 +112,11 @@ void FirFilterDialog::update_dialog() {
         float min_value = std::numeric_limits<float>::max();
         float max_value = std::numeric_limits<float>::min();
         for (size_t i = 0; i < plot_values.size(); ++i) {
-            float real = static_cast<float>(fft.output_buffer()[i][0]);
+            float real = fft.output_buffer()[i][0];
             if (std::isinf(real))
                 real = 0;
 
-            float imag = static_cast<float>(fft.output_buffer()[i][1]);
+            float imag = fft.output_buffer()[i][1];
             if (std::isinf(imag))
                 imag = 0;
 
@@ -31,8 +31,12 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <FL/Fl_Button.H>
 #include <FL/Fl_Spinner.H>
 #include <FL/Fl_Tile.H>
+#include <FL/fl_ask.H>
 #include <decoder/Decoder.hpp>
+#include <ui/BiquadFilterDialog.hpp>
 #include <ui/FirFilterDialog.hpp>
+#include <ui/IQMixerDialog.hpp>
+#include <ui/MovingAverageDialog.hpp>
 #include <ui/ScopeDialog.hpp>
 #include <ui/WaterfallDialog.hpp>
 #include <ui/component/Scope.hpp>
@@ -44,6 +48,10 @@ using namespace Ui;
 
 static constexpr const char* s_conf_scope { "MainGui.Scope" };
 static constexpr const char* s_conf_waterfall { "MainGui.GlobalWaterfall" };
+/* Renamed whenever Waterfall::Settings changes its layout, older save files would not load otherwise */
+static constexpr const char* s_conf_decoder_waterfall { "Base.Waterfall" };
+static constexpr const char* s_conf_decoder_center_frequency { "Base.CenterFrequency" };
+static constexpr u8 decoder_ui_padding { 8 };
 static constexpr u8 header_component_height { 30 };
 static constexpr u8 default_monitor_area_height { 100 };
 static constexpr u8 default_scope_width { 175 };
@@ -192,6 +200,37 @@ void MainGui::update_center_frequency() {
     m_frequency_spinner->value(Drtd::active_decoder()->center_frequency());
 }
 
+void MainGui::use_decoder(std::shared_ptr<Dsp::DecoderBase>& decoder) {
+    m_content_box->clear();
+    auto* root = decoder->build_ui({ m_content_box->x() + decoder_ui_padding, m_content_box->y() + decoder_ui_padding },
+                                   { static_cast<unsigned>(m_content_box->w() - 2 * decoder_ui_padding),
+                                     static_cast<unsigned>(m_content_box->h() - 2 * decoder_ui_padding) });
+    if (root) {
+        m_content_box->add(root);
+        m_content_box->resizable(root);
+    }
+    m_content_box->redraw();
+
+    const int min_window_height = std::max(static_cast<int>(default_window_height), window_padding + decoder->min_ui_height());
+    size_range(default_window_width, min_window_height);
+    set_min_content_box_height(decoder->min_ui_height());
+    m_waterfall->set_decoder(decoder);
+
+    auto settings = m_waterfall->settings();
+    Util::Config::load(decoder->config_path(s_conf_decoder_waterfall), settings, settings);
+    m_waterfall->update_settings_later(settings);
+    Hertz center_frequency = decoder->center_frequency();
+    Util::Config::load(decoder->config_path(s_conf_decoder_center_frequency), center_frequency, center_frequency);
+    decoder->set_center_frequency(center_frequency);
+
+    update_decoder();
+}
+
+void MainGui::save_decoder_settings(const Dsp::DecoderBase& decoder) {
+    Util::Config::save(decoder.config_path(s_conf_decoder_waterfall), m_waterfall->settings());
+    Util::Config::save(decoder.config_path(s_conf_decoder_center_frequency), decoder.center_frequency());
+}
+
 void MainGui::update_decoder() {
     ConfigDialog::refresh();
     WaterfallDialog::load_from_waterfall(m_waterfall->new_settings());
@@ -231,3 +270,52 @@ void MainGui::monitor(float a) {
     m_scope->process_sample(a);
     m_waterfall->process_sample(a);
 }
+
+void MainGui::set_monitor_sample_rate(SampleRate sample_rate) {
+    m_waterfall->set_sample_rate(sample_rate);
+}
+
+void MainGui::show_marker(bool show) {
+    m_waterfall->show_marker(show);
+}
+
+void MainGui::show_message(const std::string& message) {
+    fl_message("%s", message.c_str());
+}
+
+void MainGui::redraw_waterfall() {
+    m_waterfall->force_redraw();
+}
+
+void MainGui::show_config_dialog(Pipe::ConfigRef<Dsp::Biquad::FilterBase> filter) {
+    BiquadFilterDialog::show_dialog(filter);
+}
+
+void MainGui::show_config_dialog(Pipe::ConfigRef<Dsp::FirFilterBase> filter) {
+    FirFilterDialog::show_dialog(filter);
+}
+
+void MainGui::show_config_dialog(Pipe::ConfigRef<Dsp::IQMixer> mixer) {
+    IQMixerDialog::show_dialog(mixer);
+}
+
+void MainGui::show_config_dialog(Pipe::ConfigRef<Dsp::MovingAverageBase> filter) {
+    MovingAverageDialog::show_dialog(filter);
+}
+
+/* The dialogs only update themselves while they are open */
+void MainGui::update_config_dialog(const Dsp::Biquad::FilterBase&) {
+    BiquadFilterDialog::update_dialog();
+}
+
+void MainGui::update_config_dialog(const Dsp::FirFilterBase&) {
+    FirFilterDialog::update_dialog();
+}
+
+void MainGui::update_config_dialog(const Dsp::IQMixer&) {
+    IQMixerDialog::update_dialog();
+}
+
+void MainGui::update_config_dialog(const Dsp::MovingAverageBase&) {
+    MovingAverageDialog::update_dialog();
+}
@@ -28,6 +28,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #pragma once
 
 #include <FL/Fl_Double_Window.H>
+#include <UserInterface.hpp>
+#include <memory>
 #include <util/CallbackManager.hpp>
 #include <util/Point.hpp>
 #include <util/Size.hpp>
@@ -39,12 +41,17 @@ class Fl_Tile;
 class Fl_Choice;
 class Fl_Box;
 
+namespace Dsp {
+class DecoderBase;
+}
+
 namespace Ui {
 
 class Scope;
 class Waterfall;
 
-class MainGui final : public Fl_Double_Window {
+class MainGui final : public Fl_Double_Window
+    , public Drtd::UserInterface {
 public:
     static constexpr u16 default_window_width { 640 };
     static constexpr u16 default_window_height { 480 };
@@ -58,16 +65,31 @@ public:
     };
 
     MainGui(u8 initial_decoder, WindowProperties properties);
-    void monitor(float);
-    void update_center_frequency();
-    void update_decoder();
-    void update_snr(float);
+    /* Builds the decoder UI after its setup, the waterfall and center frequency are restored per decoder */
+    void use_decoder(std::shared_ptr<Dsp::DecoderBase>&);
+    void save_decoder_settings(const Dsp::DecoderBase&);
     void hide_snr();
 
+    virtual void monitor(float) override;
+    virtual void set_monitor_sample_rate(SampleRate) override;
+    virtual void show_marker(bool) override;
+    virtual void show_message(const std::string&) override;
+    virtual void set_status(const std::string&) override;
+    virtual void update_snr(float) override;
+    virtual void update_center_frequency() override;
+    virtual void redraw_waterfall() override;
+    virtual void show_config_dialog(Pipe::ConfigRef<Dsp::Biquad::FilterBase>) override;
+    virtual void show_config_dialog(Pipe::ConfigRef<Dsp::FirFilterBase>) override;
+    virtual void show_config_dialog(Pipe::ConfigRef<Dsp::IQMixer>) override;
+    virtual void show_config_dialog(Pipe::ConfigRef<Dsp::MovingAverageBase>) override;
+    virtual void update_config_dialog(const Dsp::Biquad::FilterBase&) override;
+    virtual void update_config_dialog(const Dsp::FirFilterBase&) override;
+    virtual void update_config_dialog(const Dsp::IQMixer&) override;
+    virtual void update_config_dialog(const Dsp::MovingAverageBase&) override;
+
     Scope& scope() const { return *m_scope; }
     Waterfall& waterfall() const { return *m_waterfall; }
     Fl_Group& content_box() { return *m_content_box; };
-    void set_status(const std::string&);
     void set_min_content_box_height(u16 height) {
         m_min_content_box_height = height;
         ensure_content_box_size();
@@ -75,6 +97,7 @@ public:
     virtual int handle(int) override;
 
 private:
+    void update_decoder();
     void close_all();
     void ensure_content_box_size();
     void resize_monitor_area(u16 height);
@@ -98,7 +98,7 @@ void MovingAverageDialog::update_dialog() {
         s_moving_average_dialog->m_taps->value(taps);
         constexpr Hertz min_fft_hz_per_bin = 1;
         auto bins = std::max(taps * 2, s_current_filter->sample_rate() / min_fft_hz_per_bin);
-        FFT fft(bins);
+        FFT fft(bins, FFT::Planning::Estimate);
         std::fill(fft.input_buffer().begin(), fft.input_buffer().end(), 0);
         std::fill(fft.input_buffer().begin(), fft.input_buffer().begin() + taps, 1 / static_cast<float>(taps));
         fft.execute();
@@ -108,11 +108,11 @@ void MovingAverageDialog::update_dialog() {
         float min_value = std::numeric_limits<float>::max();
         float max_value = std::numeric_limits<float>::min();
         for (size_t i = 0; i < plot_values.size(); ++i) {
-            float real = static_cast<float>(fft.output_buffer()[i][0]);
+            float real = fft.output_buffer()[i][0];
             if (std::isinf(real))
                 real = 0;
 
-            float imag = static_cast<float>(fft.output_buffer()[i][1]);
+            float imag = fft.output_buffer()[i][1];
             if (std::isinf(imag))
                 imag = 0;
 
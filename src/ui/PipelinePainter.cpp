@@ -0,0 +1,101 @@
+/*
+BSD 2-Clause License
+
+Copyright (c) 2020, Till Mayer
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "PipelinePainter.hpp"
+#include <FL/fl_draw.H>
+
+using namespace Ui;
+
+static_assert(Pipe::Painter::black == FL_BLACK);
+static_assert(Pipe::Painter::dark_green == FL_DARK_GREEN);
+
+u32 PipelinePainter::color() const {
+    return fl_color();
+}
+
+void PipelinePainter::set_color(u32 color) {
+    fl_color(color);
+}
+
+void PipelinePainter::set_line_width(int width) {
+    if (width)
+        fl_line_style(FL_CAP_SQUARE, width);
+    else
+        fl_line_style(0);
+}
+
+void PipelinePainter::line(int x, int y, int x1, int y1) {
+    fl_line(x, y, x1, y1);
+}
+
+void PipelinePainter::horizontal_line(int x, int y, int x1) {
+    fl_xyline(x, y, x1);
+}
+
+void PipelinePainter::vertical_line(int x, int y, int y1) {
+    fl_yxline(x, y, y1);
+}
+
+void PipelinePainter::rect(int x, int y, int width, int height) {
+    fl_rect(x, y, width, height);
+}
+
+void PipelinePainter::circle(double x, double y, double radius) {
+    fl_circle(x, y, radius);
+}
+
+void PipelinePainter::polygon(int x0, int y0, int x1, int y1, int x2, int y2, int x3, int y3) {
+    fl_polygon(x0, y0, x1, y1, x2, y2, x3, y3);
+}
+
+void PipelinePainter::pixmap(const char* const* xpm, int x, int y) {
+    fl_draw_pixmap(xpm, x, y);
+}
+
+void PipelinePainter::begin_line() {
+    fl_begin_line();
+}
+
+void PipelinePainter::vertex(double x, double y) {
+    fl_vertex(x, y);
+}
+
+void PipelinePainter::end_line() {
+    fl_end_line();
+}
+
+void PipelinePainter::push_matrix() {
+    fl_push_matrix();
+}
+
+void PipelinePainter::translate(double x, double y) {
+    fl_translate(x, y);
+}
+
+void PipelinePainter::pop_matrix() {
+    fl_pop_matrix();
+}
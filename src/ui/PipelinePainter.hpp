@@ -0,0 +1,57 @@
+/*
+BSD 2-Clause License
+
+Copyright (c) 2020, Till Mayer
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#pragma once
+
+#include <pipe/Painter.hpp>
+
+namespace Ui {
+
+/* Draws the pipeline with fl_draw, into whatever surface is current */
+class PipelinePainter final : public Pipe::Painter {
+public:
+    virtual u32 color() const override;
+    virtual void set_color(u32 color) override;
+    virtual void set_line_width(int width) override;
+
+    virtual void line(int x, int y, int x1, int y1) override;
+    virtual void horizontal_line(int x, int y, int x1) override;
+    virtual void vertical_line(int x, int y, int y1) override;
+    virtual void rect(int x, int y, int width, int height) override;
+    virtual void circle(double x, double y, double radius) override;
+    virtual void polygon(int x0, int y0, int x1, int y1, int x2, int y2, int x3, int y3) override;
+    virtual void pixmap(const char* const* xpm, int x, int y) override;
+
+    virtual void begin_line() override;
+    virtual void vertex(double x, double y) override;
+    virtual void end_line() override;
+    virtual void push_matrix() override;
+    virtual void translate(double x, double y) override;
+    virtual void pop_matrix() override;
+};
+
+}
@@ -46,7 +46,7 @@ ScopeDialog::ScopeDialog()
     m_zoom.type(FL_HOR_NICE_SLIDER);
     m_zoom.align(FL_ALIGN_LEFT);
     m_zoom.selection_color(Util::s_amber_color);
-    m_zoom.bounds(-50, 50);
+    m_zoom.bounds(-120, 50);
     m_zoom.callback(save_to_scope);
 
     m_reset_zoom.callback([](Fl_Widget*, void*) {
@@ -30,6 +30,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <sstream>
 #include <ui/MainGui.hpp>
 #include <util/Singleton.hpp>
+#include <util/SpectrumAverager.hpp>
 #include <util/Util.hpp>
 
 using namespace Ui;
@@ -37,7 +38,7 @@ using namespace Ui;
 const std::array s_bins { "1024", "2048", "4096", "8192", "16384", "32768", "65536" };
 
 WaterfallDialog::WaterfallDialog()
-    : Fl_Window(100, 100, 360, 204, "Waterfall settings")
+    : Fl_Window(100, 100, 360, 233, "Waterfall settings")
     , m_window(85, 4, 0, 25, "Window:")
     , m_zoom(m_window.x(), m_window.y() + m_window.h() + 4, w() - m_window.x() - 24, 25, "Zoom:")
     , m_reset_zoom(m_zoom.x() + m_zoom.w() + 4, m_zoom.y(), 15, m_zoom.h(), "R")
@@ -45,7 +46,10 @@ WaterfallDialog::WaterfallDialog()
     , m_speed_multiplier(m_window.x(), m_bin_offset.y() + m_bin_offset.h() + 4, w() - m_window.x() - 4, 25, "Speed:")
     , m_bins(m_window.x(), m_speed_multiplier.y() + m_speed_multiplier.h() + 4, 150, 25, "Bins:")
     , m_palette(m_window.x(), m_bins.y() + m_bins.h() + 4, 0, 25, "Palette:")
-    , m_power_spectrum(m_window.x(), m_palette.y() + m_palette.h() + 4, 180, 25, "Show power spectrum") {
+    , m_averaged_frames(m_window.x(), m_palette.y() + m_palette.h() + 4, 60, 25, "Averaging:")
+    , m_overlap(m_averaged_frames.x() + m_averaged_frames.w() + 70, m_averaged_frames.y(), 80, 25, "Overlap:")
+    , m_power_spectrum(m_window.x(), m_averaged_frames.y() + m_averaged_frames.h() + 4, 180, 25, "Show power spectrum")
+    , m_peak_hold(m_power_spectrum.x() + m_power_spectrum.w(), m_power_spectrum.y(), 90, 25, "Peak hold") {
     double max_width = 0;
 
     for (auto& window : Dsp::Window::s_windows) {
@@ -91,7 +95,18 @@ WaterfallDialog::WaterfallDialog()
     m_palette.size(static_cast<int>(max_width + 40), m_palette.h());
     m_palette.callback(save_to_waterfall);
 
+    m_averaged_frames.align(FL_ALIGN_LEFT);
+    m_averaged_frames.range(1, Util::SpectrumAverager::max_frames);
+    m_averaged_frames.step(1);
+    m_averaged_frames.callback(save_to_waterfall);
+
+    m_overlap.add("None");
+    m_overlap.add("50%");
+    m_overlap.add("75%");
+    m_overlap.callback(save_to_waterfall);
+
     m_power_spectrum.callback(save_to_waterfall);
+    m_peak_hold.callback(save_to_waterfall);
 }
 
 void WaterfallDialog::show_dialog() {
@@ -113,6 +128,9 @@ void WaterfallDialog::save_to_waterfall(Fl_Widget*, void*) {
     new_settings.speed_multiplier = static_cast<u8>(s_waterfall_dialog->m_speed_multiplier.value());
     new_settings.bins = std::atoi(s_bins[static_cast<u32>(s_waterfall_dialog->m_bins.value())]);
     new_settings.power_spectrum = static_cast<bool>(s_waterfall_dialog->m_power_spectrum.value());
+    new_settings.averaged_frames = static_cast<u8>(s_waterfall_dialog->m_averaged_frames.value());
+    new_settings.overlap = static_cast<Waterfall::Overlap>(s_waterfall_dialog->m_overlap.value());
+    new_settings.peak_hold = static_cast<bool>(s_waterfall_dialog->m_peak_hold.value());
     s_waterfall_dialog->update_offset_spinner_limits(new_settings);
     new_settings.bin_offset = static_cast<u32>(Waterfall::translate_hz_to_x(new_settings, static_cast<Hertz>(s_waterfall_dialog->m_bin_offset.value()), waterfall.sample_rate()));
 
@@ -140,5 +158,8 @@ void WaterfallDialog::load_from_waterfall(const Waterfall::Settings& settings) {
     s_waterfall_dialog->m_bin_offset.value(Waterfall::translate_x_to_hz(settings, settings.bin_offset, waterfall.sample_rate()));
     s_waterfall_dialog->m_bins.value(s_waterfall_dialog->m_bins.find_item(std::to_string(settings.bins).c_str()));
     s_waterfall_dialog->m_palette.value(waterfall.palette_index());
+    s_waterfall_dialog->m_averaged_frames.value(settings.averaged_frames);
+    s_waterfall_dialog->m_overlap.value(static_cast<int>(settings.overlap));
     s_waterfall_dialog->m_power_spectrum.value(settings.power_spectrum);
+    s_waterfall_dialog->m_peak_hold.value(settings.peak_hold);
 }
@@ -61,7 +61,10 @@ private:
     Fl_Slider m_speed_multiplier;
     Fl_Choice m_bins;
     Fl_Choice m_palette;
+    Fl_Spinner m_averaged_frames;
+    Fl_Choice m_overlap;
     Fl_Check_Button m_power_spectrum;
+    Fl_Check_Button m_peak_hold;
 };
 
 }
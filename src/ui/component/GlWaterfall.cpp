@@ -0,0 +1,244 @@
+/*
+BSD 2-Clause License
+
+Copyright (c) 2020, Till Mayer
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "GlWaterfall.hpp"
+#include <algorithm>
+#include <cstring>
+#include <util/Logger.hpp>
+
+using namespace Ui;
+
+static const Util::Logger s_log("GlWaterfall");
+
+static constexpr const char* s_vertex_shader {
+    "#version 110\n"
+    "void main() {\n"
+    "    gl_TexCoord[0] = gl_MultiTexCoord0;\n"
+    "    gl_Position = gl_Vertex;\n"
+    "}\n"
+};
+
+/* The alpha channel of the history is 0 right of the last bin of a row, that area is filled with the background */
+static constexpr const char* s_fragment_shader {
+    "#version 110\n"
+    "uniform sampler2D history;\n"
+    "uniform sampler2D palette;\n"
+    "uniform vec3 background;\n"
+    "void main() {\n"
+    "    vec4 entry = texture2D(history, gl_TexCoord[0].st);\n"
+    "    vec3 color = texture2D(palette, vec2((entry.r * 255.0 + 0.5) / 256.0, 0.5)).rgb;\n"
+    "    gl_FragColor = vec4(mix(background, color, entry.a), 1.0);\n"
+    "}\n"
+};
+
+static GLuint compile_shader(GLenum type, const char* source) {
+    GLuint shader = glCreateShader(type);
+    glShaderSource(shader, 1, &source, nullptr);
+    glCompileShader(shader);
+
+    GLint status = GL_FALSE;
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &status);
+    if (status == GL_TRUE)
+        return shader;
+
+    char log[512] {};
+    glGetShaderInfoLog(shader, sizeof(log), nullptr, log);
+    s_log.warning() << "Could not compile shader: " << log;
+    glDeleteShader(shader);
+    return 0;
+}
+
+GlWaterfall::GlWaterfall(Waterfall& waterfall, int x, int y, int w, int h)
+    : Fl_Gl_Window(x, y, w, h)
+    , m_waterfall(waterfall) {
+    mode(FL_RGB | FL_DOUBLE);
+    end();
+}
+
+bool GlWaterfall::available() {
+    return Fl_Gl_Window::can_do(FL_RGB | FL_DOUBLE);
+}
+
+void GlWaterfall::resize(int, int, int, int) {
+    /* Whoever resizes this, it always covers the history area of the waterfall */
+    const auto area = m_waterfall.history_area();
+    Fl_Gl_Window::resize(area.x, area.y, area.w, area.h);
+}
+
+void GlWaterfall::set_palette(const Palette::Table& palette) {
+    m_palette = palette;
+    m_palette_changed = true;
+    redraw();
+}
+
+void GlWaterfall::push_row(const u8* indices, u32 width) {
+    if (m_pending_count == max_pending_rows) {
+        std::rotate(m_pending_rows.begin(), m_pending_rows.begin() + 1, m_pending_rows.end());
+        --m_pending_count;
+    }
+
+    if (m_pending_count == m_pending_rows.size())
+        m_pending_rows.emplace_back();
+
+    auto& row = m_pending_rows[m_pending_count++];
+    if (row.indices.size() < width)
+        row.indices = Util::Buffer<u8>(width);
+
+    std::memcpy(row.indices.ptr(), indices, width);
+    row.width = width;
+}
+
+int GlWaterfall::handle(int event) {
+    if (m_waterfall.handle_history_event(event, Fl::event_x()))
+        return 1;
+
+    return Fl_Gl_Window::handle(event);
+}
+
+bool GlWaterfall::initialize() {
+    GLuint vertex_shader = compile_shader(GL_VERTEX_SHADER, s_vertex_shader);
+    GLuint fragment_shader = compile_shader(GL_FRAGMENT_SHADER, s_fragment_shader);
+    if (!vertex_shader || !fragment_shader)
+        return false;
+
+    m_program = glCreateProgram();
+    glAttachShader(m_program, vertex_shader);
+    glAttachShader(m_program, fragment_shader);
+    glLinkProgram(m_program);
+    glDeleteShader(vertex_shader);
+    glDeleteShader(fragment_shader);
+
+    GLint status = GL_FALSE;
+    glGetProgramiv(m_program, GL_LINK_STATUS, &status);
+    if (status != GL_TRUE) {
+        s_log.warning() << "Could not link shader program";
+        return false;
+    }
+
+    glUseProgram(m_program);
+    glUniform1i(glGetUniformLocation(m_program, "history"), 0);
+    glUniform1i(glGetUniformLocation(m_program, "palette"), 1);
+    m_background_uniform = glGetUniformLocation(m_program, "background");
+
+    glGenTextures(1, &m_history_texture);
+    glGenTextures(1, &m_palette_texture);
+    for (auto texture : { m_history_texture, m_palette_texture }) {
+        glBindTexture(GL_TEXTURE_2D, texture);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, texture == m_history_texture ? GL_REPEAT : GL_CLAMP_TO_EDGE);
+    }
+
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    m_history_width = 0;
+    m_history_height = 0;
+    m_palette_changed = true;
+    return glGetError() == GL_NO_ERROR;
+}
+
+void GlWaterfall::recreate_history() {
+    m_history_width = static_cast<u32>(w());
+    m_history_height = static_cast<u32>(h());
+    m_head = 0;
+
+    /* Palette index 0 with full alpha, the same black the software renderer starts with */
+    Util::Buffer<u8> empty(m_history_width * m_history_height * 2);
+    for (size_t i = 1; i < empty.size(); i += 2)
+        empty[i] = 0xFF;
+
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, m_history_texture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_LUMINANCE8_ALPHA8, static_cast<GLsizei>(m_history_width), static_cast<GLsizei>(m_history_height), 0, GL_LUMINANCE_ALPHA, GL_UNSIGNED_BYTE, empty.ptr());
+    m_upload = Util::Buffer<u8>(m_history_width * 2);
+}
+
+void GlWaterfall::upload_row(const PendingRow& row) {
+    const u32 width = std::min(row.width, m_history_width);
+    for (u32 x = 0; x < width; ++x) {
+        m_upload[x * 2] = row.indices[x];
+        m_upload[x * 2 + 1] = 0xFF;
+    }
+
+    std::fill(m_upload.ptr() + width * 2, m_upload.ptr() + m_upload.size(), 0);
+
+    /* The newest row is always at the top, so the head moves up through the texture */
+    m_head = (m_head + m_history_height - 1) % m_history_height;
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, static_cast<GLint>(m_head), static_cast<GLsizei>(m_history_width), 1, GL_LUMINANCE_ALPHA, GL_UNSIGNED_BYTE, m_upload.ptr());
+}
+
+void GlWaterfall::draw() {
+    if (m_failed || w() <= 0 || h() <= 0)
+        return;
+
+    if (!context_valid() && !initialize()) {
+        s_log.warning() << "OpenGL setup failed, falling back to the software renderer";
+        m_failed = true;
+        return;
+    }
+
+    if (!valid())
+        glViewport(0, 0, pixel_w(), pixel_h());
+
+    glUseProgram(m_program);
+
+    if (m_palette_changed) {
+        glActiveTexture(GL_TEXTURE1);
+        glBindTexture(GL_TEXTURE_2D, m_palette_texture);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB8, Palette::table_size, 1, 0, GL_RGB, GL_UNSIGNED_BYTE, m_palette.data());
+
+        uchar red = 0;
+        uchar green = 0;
+        uchar blue = 0;
+        Fl::get_color(FL_GRAY, red, green, blue);
+        glUniform3f(m_background_uniform, red / 255.f, green / 255.f, blue / 255.f);
+        m_palette_changed = false;
+    }
+
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, m_history_texture);
+    if (m_history_width != static_cast<u32>(w()) || m_history_height != static_cast<u32>(h()))
+        recreate_history();
+
+    /* Rows that would scroll out right away are not uploaded at all */
+    const size_t skipped = m_pending_count > m_history_height ? m_pending_count - m_history_height : 0;
+    for (size_t i = skipped; i < m_pending_count; ++i)
+        upload_row(m_pending_rows[i]);
+    m_pending_count = 0;
+
+    const float top = static_cast<float>(m_head) / static_cast<float>(m_history_height);
+    glBegin(GL_QUADS);
+    glTexCoord2f(0, top);
+    glVertex2f(-1, 1);
+    glTexCoord2f(1, top);
+    glVertex2f(1, 1);
+    glTexCoord2f(1, top + 1);
+    glVertex2f(1, -1);
+    glTexCoord2f(0, top + 1);
+    glVertex2f(-1, -1);
+    glEnd();
+}
@@ -0,0 +1,87 @@
+/*
+BSD 2-Clause License
+
+Copyright (c) 2020, Till Mayer
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#pragma once
+
+#define GL_GLEXT_PROTOTYPES
+#include "Waterfall.hpp"
+#include <FL/Fl_Gl_Window.H>
+#include <FL/gl.h>
+#include <util/Buffer.hpp>
+#include <util/Types.hpp>
+#include <vector>
+
+namespace Ui {
+
+/*
+ * Draws the waterfall history with OpenGL. The history is a texture used as a ring buffer: a new row only uploads
+ * itself and scrolling moves the texture coordinates. Palette indices are turned into colors by a fragment shader.
+ * Only needs OpenGL 2.0, so it also runs on software rasterizers.
+ */
+class GlWaterfall final : public Fl_Gl_Window {
+public:
+    GlWaterfall(Waterfall&, int x, int y, int w, int h);
+
+    static bool available();
+    bool failed() const { return m_failed; }
+    void set_palette(const Palette::Table&);
+    void push_row(const u8* indices, u32 width);
+
+    virtual void resize(int x, int y, int w, int h) override;
+
+private:
+    struct PendingRow {
+        Util::Buffer<u8> indices;
+        u32 width { 0 };
+    };
+
+    /* Rows beyond this are dropped before they are uploaded, the history never gets taller */
+    static constexpr size_t max_pending_rows { 4096 };
+
+    virtual void draw() override;
+    virtual int handle(int event) override;
+    bool initialize();
+    void recreate_history();
+    void upload_row(const PendingRow&);
+
+    Waterfall& m_waterfall;
+    GLuint m_program { 0 };
+    GLuint m_history_texture { 0 };
+    GLuint m_palette_texture { 0 };
+    GLint m_background_uniform { 0 };
+    u32 m_history_width { 0 };
+    u32 m_history_height { 0 };
+    u32 m_head { 0 };
+    std::vector<PendingRow> m_pending_rows;
+    size_t m_pending_count { 0 };
+    Util::Buffer<u8> m_upload;
+    Palette::Table m_palette {};
+    bool m_palette_changed { true };
+    bool m_failed { false };
+};
+
+}
@@ -43,102 +43,103 @@ int Scope::handle(int event) {
     return Canvas::handle(event);
 }
 
+void Scope::start_capture(u32 layer_width) {
+    const u32 abs_zoom = static_cast<u32>(std::abs(m_settings.zoom));
+    const bool oversampling = m_settings.zoom > 0;
+
+    m_column_step = oversampling ? abs_zoom + 1 : 1;
+    m_samples_per_column = oversampling ? 1 : abs_zoom + 1;
+    m_column_count = (layer_width + m_column_step - 1) / m_column_step;
+    if (m_columns.size() < m_column_count)
+        m_columns = Util::Buffer<Span>(m_column_count);
+
+    m_sample_max = std::numeric_limits<float>::lowest();
+    m_sample_min = std::numeric_limits<float>::max();
+}
+
+void Scope::draw_columns() {
+    recalculate_bias();
+    const float bias = real_bias();
+    const auto layer_width = m_layer->current_width();
+    const auto layer_height = m_layer->current_height();
+    const float half_height = static_cast<float>(layer_height / 2);
+
+    float adj_max;
+    if (m_settings.normalized) {
+        adj_max = 1;
+    } else {
+        adj_max = std::max(m_sample_max, std::abs(m_sample_min)) - bias;
+        adj_max *= 1.1f;
+    }
+
+    const auto to_y = [&](float sample) {
+        return static_cast<int>((sample - bias) / adj_max * -half_height + half_height);
+    };
+
+    {
+        Ui::LayerDraw draw(m_layer);
+
+        fl_rectf(0, 0, layer_width, layer_height, m_layer->clear_color());
+        fl_color(FL_GRAY);
+        fl_line(0, static_cast<int>(half_height), layer_width - 1, static_cast<int>(half_height));
+
+        fl_color(FL_RED);
+        if (adj_max > 0 && m_column_step > 1) {
+            /* Zoomed in, every column holds a single sample */
+            Util::Point last_point(0, to_y(m_columns[0].min));
+            for (u32 i = 1; i < m_column_count; ++i) {
+                Util::Point p(static_cast<int>(i * m_column_step), to_y(m_columns[i].min));
+                fl_line(last_point.x(), last_point.y(), last_point.x(), p.y(), p.x(), p.y());
+                last_point = p;
+            }
+        } else if (adj_max > 0) {
+            /* Every column is one vertical span, widened to reach the previous one so the trace stays connected */
+            for (u32 x = 0; x < m_column_count; ++x) {
+                float low = m_columns[x].min;
+                float high = m_columns[x].max;
+                if (x > 0) {
+                    low = std::min(low, m_columns[x - 1].max);
+                    high = std::max(high, m_columns[x - 1].min);
+                }
+
+                fl_yxline(static_cast<int>(x), to_y(high), to_y(low));
+            }
+        }
+    }
+
+    damage(FL_DAMAGE_ALL);
+}
+
 void Scope::process_sample(float sample) {
     if (m_paused && !m_single_shot)
         return;
 
-    bool oversampling = m_settings.zoom > 0;
-    auto abs_zoom = std::abs(m_settings.zoom);
     auto layer_width = m_layer->current_width();
     auto layer_height = m_layer->current_height();
 
     if (layer_width < 10 || layer_height < 10)
         return;
 
-    if ((!oversampling && m_samples_captured >= m_width) || (oversampling && m_samples_captured * abs_zoom >= m_width)) {
-        if (m_limiter.limit() && m_samples.size()) {
-            recalculate_bias();
-            const float bias = real_bias();
-            float adj_max;
-            u32 half_height = m_layer->current_height() / 2;
-
-            if (m_settings.normalized) {
-                adj_max = 1;
-            } else {
-                adj_max = std::max(m_sample_max, std::abs(m_sample_min)) - bias;
-                adj_max *= 1.1f;
-            }
-
-            {
-                Ui::LayerDraw draw(m_layer);
-
-                fl_rectf(0, 0, layer_width, layer_height, m_layer->clear_color());
-                fl_color(FL_GRAY);
-                fl_line(0, half_height, layer_width - 1, half_height);
-
-                fl_color(FL_RED);
-                if (adj_max > 0) {
-                    unsigned x = 0;
-                    Util::Point last_point;
-                    bool first = true;
-
-                    for (unsigned i = 0; i < m_width; ++i) {
-                        float buffer_sample = m_samples[i];
-                        Util::Point p(x, static_cast<int>((((buffer_sample - bias) / adj_max) * -static_cast<float>(half_height) + static_cast<float>(half_height))));
-                        if (first) {
-                            last_point = p;
-                            first = false;
-                            continue;
-                        }
-
-                        fl_line(last_point.x(), last_point.y(), last_point.x(), p.y(), p.x(), p.y());
-
-                        if ((last_point.x() + abs_zoom) >= static_cast<int>(m_width) && oversampling)
-                            break;
-
-                        last_point = p;
-                        ++x;
-                        if (oversampling)
-                            x += abs_zoom;
-                    }
-                }
-            }
-
-            damage(FL_DAMAGE_ALL);
-        }
+    if (m_columns_captured == 0 && m_column_samples == 0)
+        start_capture(layer_width);
 
-        m_samples_captured = 0;
-        m_single_shot = false;
-    }
+    m_column.min = std::min(m_column.min, sample);
+    m_column.max = std::max(m_column.max, sample);
+    if (++m_column_samples < m_samples_per_column)
+        return;
 
-    if (m_samples_captured == 0) {
-        recalculate_bias();
-        m_sample_max = std::max(m_sample_max, sample);
-        m_sample_min = std::min(m_sample_min, sample);
-        if (layer_width != m_width) {
-            m_width = layer_width;
-            m_samples = Util::Buffer<float>(m_width);
-        }
+    m_sample_min = std::min(m_sample_min, m_column.min);
+    m_sample_max = std::max(m_sample_max, m_column.max);
+    m_columns[m_columns_captured++] = m_column;
+    m_column = {};
+    m_column_samples = 0;
 
-        m_sample_max = std::numeric_limits<float>::min();
-        m_sample_min = std::numeric_limits<float>::max();
-    }
+    if (m_columns_captured < m_column_count)
+        return;
 
-    if (abs_zoom == 0 || oversampling) {
-        m_samples[m_samples_captured++] = sample;
-        m_sample_max = std::max(m_sample_max, sample);
-        m_sample_min = std::min(m_sample_min, sample);
-    } else if (m_samples_averaged > static_cast<u32>(abs_zoom)) {
-        float avgSample = m_sample_average / static_cast<float>(abs_zoom + 1);
-        m_samples[m_samples_captured++] = avgSample;
-        m_sample_max = std::max(m_sample_max, avgSample);
-        m_sample_min = std::min(m_sample_min, avgSample);
-        m_samples_averaged = 0;
-        m_sample_average = 0;
-    } else {
-        ++m_samples_averaged;
-        m_sample_average += sample;
-    }
+    if (m_limiter.limit())
+        draw_columns();
 
-    m_last_sample = sample;
+    m_columns_captured = 0;
+    m_single_shot = false;
 }
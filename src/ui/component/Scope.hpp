@@ -55,22 +55,33 @@ public:
     void set_paused(bool paused) { m_paused = paused; }
 
 private:
+    /* The extremes of the samples that fall into one pixel column */
+    struct Span {
+        float min { std::numeric_limits<float>::max() };
+        float max { std::numeric_limits<float>::lowest() };
+    };
+
     virtual int handle(int event) override;
     void recalculate_bias();
     float real_bias() { return m_settings.remove_dc_bias ? m_dc_bias : 0; }
+    void start_capture(u32 layer_width);
+    void draw_columns();
 
     std::shared_ptr<Layer> m_layer;
     Settings m_settings;
     Util::Limiter m_limiter { 30 };
-    Util::Buffer<float> m_samples;
-    u32 m_width { 1 };
-    u32 m_samples_captured { 0 };
-    u32 m_samples_averaged { 0 };
-    float m_sample_average { 0 };
-    float m_sample_max { std::numeric_limits<float>::min() };
+    /* Only grows, so resizing the scope does not allocate on every capture */
+    Util::Buffer<Span> m_columns;
+    Span m_column;
+    u32 m_column_count { 0 };
+    u32 m_columns_captured { 0 };
+    u32 m_column_samples { 0 };
+    u32 m_samples_per_column { 1 };
+    /* Pixels between two samples when zoomed in, 1 otherwise */
+    u32 m_column_step { 1 };
+    float m_sample_max { std::numeric_limits<float>::lowest() };
     float m_sample_min { std::numeric_limits<float>::max() };
     float m_dc_bias { 0 };
-    float m_last_sample { 0 };
     bool m_single_shot { false };
     bool m_paused { false };
 };
@@ -0,0 +1,382 @@
+/*
+BSD 2-Clause License
+
+Copyright (c) 2020, Till Mayer
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "SpectrumWorker.hpp"
+#include <FL/Fl.H>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <dsp/Window.hpp>
+#include <util/Util.hpp>
+
+using namespace Ui;
+
+SpectrumWorker::SpectrumWorker(Waterfall& waterfall)
+    : m_waterfall(waterfall)
+    , m_batch(batch_size) {
+    m_thread = std::thread(&SpectrumWorker::run, this);
+}
+
+SpectrumWorker::~SpectrumWorker() {
+    {
+        std::lock_guard lock(m_mutex);
+        m_stop = true;
+    }
+
+    m_samples_available.notify_one();
+    m_thread.join();
+}
+
+void SpectrumWorker::flush_batch() {
+    {
+        std::lock_guard lock(m_mutex);
+        /* Drop the batch if the worker can not keep up, rather than blocking the decoder */
+        for (size_t i = 0; i < m_batch_fill && !m_input.is_full(); ++i)
+            m_input.push(m_batch[i]);
+    }
+
+    m_batch_fill = 0;
+    m_samples_available.notify_one();
+}
+
+void SpectrumWorker::set_settings(const Waterfall::Settings& settings, const Waterfall::GlobalSettings& global_settings, SampleRate sample_rate) {
+    std::lock_guard lock(m_mutex);
+    m_new_settings = settings;
+    m_new_global_settings = global_settings;
+    m_new_sample_rate = sample_rate;
+    m_settings_changed = true;
+}
+
+void SpectrumWorker::take_rows(std::vector<Row>& rows) {
+    std::lock_guard lock(m_mutex);
+    std::swap(rows, m_finished_rows);
+    m_finished_rows.clear();
+    m_wakeup_pending = false;
+}
+
+void SpectrumWorker::recycle_rows(std::vector<Row>& rows) {
+    std::lock_guard lock(m_mutex);
+    for (auto& row : rows) {
+        if (m_free_rows.size() >= max_pending_rows)
+            break;
+
+        m_free_rows.push_back(std::move(row));
+    }
+
+    rows.clear();
+}
+
+void SpectrumWorker::run() {
+    std::vector<float> samples;
+    samples.reserve(input_capacity);
+
+    while (true) {
+        Waterfall::Settings settings;
+        Waterfall::GlobalSettings global_settings;
+        SampleRate sample_rate = 0;
+        bool settings_changed = false;
+
+        {
+            std::unique_lock lock(m_mutex);
+            m_samples_available.wait(lock, [this] { return m_stop || m_input.count() > 0 || m_settings_changed; });
+            if (m_stop)
+                return;
+
+            while (m_input.count())
+                samples.push_back(m_input.pop());
+
+            settings_changed = m_settings_changed;
+            settings = m_new_settings;
+            global_settings = m_new_global_settings;
+            sample_rate = m_new_sample_rate;
+            m_settings_changed = false;
+        }
+
+        if (settings_changed)
+            apply_settings(settings, global_settings, sample_rate);
+
+        for (float sample : samples)
+            process(sample);
+        samples.clear();
+    }
+}
+
+void SpectrumWorker::apply_settings(const Waterfall::Settings& settings, const Waterfall::GlobalSettings& global_settings, SampleRate sample_rate) {
+    const bool bins_changed = !m_initialized || settings.bins != m_settings.bins;
+    if (bins_changed) {
+        m_samples.resize(settings.bins);
+        m_window_coefficients = Util::Buffer<float>(settings.bins);
+        m_fft = FFT(settings.bins);
+        m_sample_count = 0;
+        m_frame_sample_count = 0;
+    }
+
+    if (bins_changed || global_settings.window_index != m_global_settings.window_index)
+        Dsp::Window::s_windows[global_settings.window_index].calculate_coefficients(m_window_coefficients);
+
+    const bool palette_changed = !m_initialized || global_settings.palette_index != m_global_settings.palette_index;
+    m_settings = settings;
+    m_global_settings = global_settings;
+    m_sample_rate = sample_rate;
+    m_initialized = true;
+    m_zoom_stale = true;
+    m_averager_stale = true;
+
+    if (palette_changed)
+        Palette::build_table(m_global_settings.palette_index, m_palette_table);
+
+    const size_t down_sampled_bins = Waterfall::down_sampling(m_settings) ? Waterfall::pseudo_bins(m_settings) / 2 : 0;
+    if (m_down_sampled.size() != down_sampled_bins)
+        m_down_sampled = Util::Buffer<float>(down_sampled_bins);
+}
+
+void SpectrumWorker::process(float sample) {
+    m_samples.push(sample);
+    if (zooming_in() && m_zoom_fft.configured())
+        m_zoom_fft.process_sample(sample);
+
+    const bool row_due = m_sample_count++ >= row_hop();
+    if (row_due)
+        m_sample_count = 0;
+
+    /* Without averaging, a frame is only needed for every row */
+    bool frame_due = row_due;
+    if (averaging()) {
+        frame_due = m_frame_sample_count++ >= frame_hop();
+        if (frame_due)
+            m_frame_sample_count = 0;
+    }
+
+    if (!m_row_width.load(std::memory_order_relaxed))
+        return;
+
+    if (frame_due)
+        calculate_frame();
+
+    if (row_due)
+        calculate_row();
+}
+
+u32 SpectrumWorker::frame_hop() const {
+    u32 frame_length = m_settings.bins;
+    if (zooming_in() && m_zoom_fft.configured())
+        frame_length = static_cast<u32>(m_zoom_fft.bins() * m_zoom_fft.decimation());
+
+    switch (m_settings.overlap) {
+    case Waterfall::Overlap::Half:
+        return frame_length / 2;
+    case Waterfall::Overlap::ThreeQuarters:
+        return frame_length / 4;
+    default:
+        return frame_length;
+    }
+}
+
+SpectrumWorker::Row SpectrumWorker::take_free_row(size_t size) {
+    Row row;
+    {
+        std::lock_guard lock(m_mutex);
+        if (!m_free_rows.empty()) {
+            row = std::move(m_free_rows.back());
+            m_free_rows.pop_back();
+        }
+    }
+
+    if (row.pixels.size() != size)
+        row.pixels = Util::Buffer<u8>(size);
+
+    return row;
+}
+
+void SpectrumWorker::configure_zoom(u32 width) {
+    /*
+     * Decimate as far as possible while the visible band still fits into the pass band of the decimation filter.
+     * The zoom FFT then has the resolution of the pseudo bins, instead of stretching the bins of the real FFT.
+     */
+    const auto pseudo_bins = Waterfall::pseudo_bins(m_settings);
+    const float hz_per_pixel = Waterfall::hz_per_bin(m_settings, m_sample_rate);
+    const auto decimation = static_cast<u16>(std::clamp(.8f * static_cast<float>(pseudo_bins) / static_cast<float>(width), 1.f, static_cast<float>(max_zoom_decimation)));
+    const auto bins = static_cast<size_t>(std::lround(static_cast<float>(pseudo_bins) / decimation));
+    const float center_frequency = (static_cast<float>(m_settings.bin_offset) + static_cast<float>(width) / 2) * hz_per_pixel;
+
+    m_zoom_fft.configure(m_sample_rate, center_frequency, decimation, bins, Dsp::Window::s_windows[m_global_settings.window_index]);
+    m_zoom_width = width;
+    m_zoom_stale = false;
+}
+
+void SpectrumWorker::real_fft_power() {
+    const size_t bins = m_settings.bins;
+    auto& input = m_fft.input_buffer();
+    for (size_t i = 0; i < bins; ++i)
+        input[i] = m_samples.peek(i) * m_window_coefficients[i];
+
+    m_fft.execute();
+
+    const auto& output = m_fft.output_buffer();
+    for (size_t i = 0; i < m_frame_power.size(); ++i)
+        m_frame_power[i] = output[i][0] * output[i][0] + output[i][1] * output[i][1];
+}
+
+void SpectrumWorker::zoom_fft_power() {
+    m_zoom_fft.execute();
+
+    const auto& output = m_zoom_fft.output_buffer();
+    for (size_t i = 0; i < m_frame_power.size(); ++i)
+        m_frame_power[i] = output[i][0] * output[i][0] + output[i][1] * output[i][1];
+}
+
+void SpectrumWorker::calculate_frame() {
+    const u32 width = m_row_width.load(std::memory_order_relaxed);
+    if (zooming_in() && (m_zoom_stale || m_zoom_width != width)) {
+        configure_zoom(width);
+        m_averager_stale = true;
+    }
+
+    const size_t bins = zooming_in() ? m_zoom_fft.bins() : m_settings.bins / 2;
+    if (m_averager_stale || m_averager.bins() != bins) {
+        m_averager.reset(bins, m_settings.averaged_frames, m_settings.peak_hold);
+        m_averager_stale = false;
+    }
+
+    /* No rows are drawn until then, a partly filled frame would show a smeared spectrum */
+    if (zooming_in() && !m_zoom_fft.ready())
+        return;
+
+    if (m_frame_power.size() != bins)
+        m_frame_power = Util::Buffer<float>(bins);
+
+    if (zooming_in())
+        zoom_fft_power();
+    else
+        real_fft_power();
+
+    m_averager.add(m_frame_power);
+}
+
+u32 SpectrumWorker::real_fft_pixels(u32 width, float& max) {
+    const auto pseudo_bins = Waterfall::pseudo_bins(m_settings);
+    const bool down_sampling = Waterfall::down_sampling(m_settings);
+    const Util::Buffer<float>& bin_values = down_sampling ? m_down_sampled : m_magnitudes;
+
+    if (down_sampling) {
+        /* Every pseudo bin is the average of the bins it covers */
+        const float ratio = std::abs(m_settings.zoom) + 1;
+        for (size_t i = 0; i < m_down_sampled.size(); ++i) {
+            const size_t first = std::min(m_magnitudes.size() - 1, static_cast<size_t>(static_cast<float>(i) * ratio));
+            const size_t last = std::clamp(static_cast<size_t>(static_cast<float>(i + 1) * ratio), first + 1, m_magnitudes.size());
+
+            float sum = 0;
+            for (size_t j = first; j < last; ++j)
+                sum += m_magnitudes[j];
+
+            m_down_sampled[i] = sum / static_cast<float>(last - first);
+        }
+    }
+
+    for (size_t i = 0; i < bin_values.size(); ++i)
+        max = std::max(max, bin_values[i]);
+
+    u32 pixels = 0;
+    for (size_t i = m_settings.bin_offset; i < pseudo_bins / 2 && pixels < width; ++i, ++pixels)
+        m_pixel_values[pixels] = bin_values[i];
+
+    return pixels;
+}
+
+u32 SpectrumWorker::zoom_fft_pixels(u32 width, float& max) {
+    for (size_t i = 0; i < m_magnitudes.size(); ++i)
+        max = std::max(max, m_magnitudes[i]);
+
+    const auto pseudo_bins = Waterfall::pseudo_bins(m_settings);
+    const float hz_per_pixel = Waterfall::hz_per_bin(m_settings, m_sample_rate);
+
+    u32 pixels = 0;
+    for (size_t i = m_settings.bin_offset; i < pseudo_bins / 2 && pixels < width; ++i, ++pixels) {
+        const float offset_hz = static_cast<float>(i) * hz_per_pixel - m_zoom_fft.center_frequency();
+        m_pixel_values[pixels] = m_magnitudes[m_zoom_fft.bin_index(std::lround(offset_hz / m_zoom_fft.hz_per_bin()))];
+    }
+
+    return pixels;
+}
+
+void SpectrumWorker::calculate_row() {
+    const u32 width = m_row_width.load(std::memory_order_relaxed);
+    if (m_averager.empty() || (zooming_in() && (m_zoom_stale || m_zoom_width != width)))
+        return;
+
+    if (m_pixel_values.size() != width) {
+        m_pixel_values = Util::Buffer<float>(width);
+        m_pixel_indices = Util::Buffer<u8>(width);
+    }
+
+    /* Averaging happens on power, the square root is only taken for display */
+    const auto& power = m_averager.result();
+    if (m_magnitudes.size() != power.size())
+        m_magnitudes = Util::Buffer<float>(power.size());
+
+    if (m_settings.power_spectrum) {
+        std::copy(power.ptr(), power.ptr() + power.size(), m_magnitudes.ptr());
+    } else {
+        for (size_t i = 0; i < power.size(); ++i)
+            m_magnitudes[i] = sqrtf(power[i]);
+    }
+
+    float max = 0;
+    const u32 pixels = zooming_in() ? zoom_fft_pixels(width, max) : real_fft_pixels(width, max);
+
+    /* Written without branches, so it is vectorized. NaN fails both comparisons and ends up as 0 */
+    const float scale = max > 0 ? (Palette::table_size - 1) / max : 0;
+    constexpr float max_index = Palette::table_size - 1;
+    for (u32 x = 0; x < pixels; ++x) {
+        float index = m_pixel_values[x] * scale;
+        index = index > 0 ? index : 0;
+        index = index < max_index ? index : max_index;
+        m_pixel_indices[x] = static_cast<u8>(index + .5f);
+    }
+
+    const bool indexed = m_indexed_rows.load(std::memory_order_relaxed);
+    Row row = take_free_row(indexed ? width : width * 3);
+    if (indexed) {
+        std::memcpy(row.pixels.ptr(), m_pixel_indices.ptr(), pixels);
+    } else {
+        for (u32 x = 0; x < pixels; ++x)
+            std::memcpy(row.pixels.ptr() + x * 3, m_palette_table.data() + m_pixel_indices[x] * 3, 3);
+    }
+
+    row.width = pixels;
+    row.indexed = indexed;
+
+    std::lock_guard lock(m_mutex);
+    if (m_finished_rows.size() >= max_pending_rows)
+        m_finished_rows.erase(m_finished_rows.begin());
+
+    m_finished_rows.push_back(std::move(row));
+
+    /* One wake up is enough until the UI thread took the rows. If FLTK's queue is full, try again with the next row */
+    if (!m_wakeup_pending)
+        m_wakeup_pending = Fl::awake(&Waterfall::on_rows_finished, &m_waterfall) == 0;
+}
@@ -0,0 +1,151 @@
+/*
+BSD 2-Clause License
+
+Copyright (c) 2020, Till Mayer
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#pragma once
+
+#include "Waterfall.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <util/Buffer.hpp>
+#include <util/FFT.hpp>
+#include <util/RingBuffer.hpp>
+#include <util/SpectrumAverager.hpp>
+#include <util/ZoomFFT.hpp>
+#include <vector>
+
+namespace Ui {
+
+/*
+ * Turns the samples shown in the waterfall into rows of pixels on its own thread, so large FFTs do not take time
+ * away from the decoder. Finished rows are handed to the UI thread with Fl::awake.
+ */
+class SpectrumWorker final {
+public:
+    struct Row {
+        /* Either RGB triplets or palette indices, one byte per pixel */
+        Util::Buffer<u8> pixels;
+        u32 width { 0 };
+        bool indexed { false };
+    };
+
+    explicit SpectrumWorker(Waterfall&);
+    ~SpectrumWorker();
+
+    SpectrumWorker(const SpectrumWorker&) = delete;
+    SpectrumWorker& operator=(const SpectrumWorker&) = delete;
+
+    /* Only ever called from the processing thread */
+    void push_sample(float sample) {
+        m_batch[m_batch_fill++] = sample;
+        if (m_batch_fill == m_batch.size())
+            flush_batch();
+    }
+
+    void set_row_width(u32 width) { m_row_width.store(width, std::memory_order_relaxed); }
+    /* Palette indices are produced for renderers that color the rows themselves */
+    void set_indexed_rows(bool indexed) { m_indexed_rows.store(indexed, std::memory_order_relaxed); }
+    void set_settings(const Waterfall::Settings&, const Waterfall::GlobalSettings&, SampleRate);
+    /* Moves the rows finished since the last call into rows, oldest first */
+    void take_rows(std::vector<Row>& rows);
+    /* Hands drawn rows back, so their pixel buffers can be reused */
+    void recycle_rows(std::vector<Row>& rows);
+
+private:
+    /* Samples are handed over in batches, so the processing thread rarely takes the lock */
+    static constexpr size_t batch_size { 256 };
+    static constexpr size_t input_capacity { 1 << 16 };
+    /* If the UI thread falls behind, the oldest rows are dropped */
+    static constexpr size_t max_pending_rows { 64 };
+    static constexpr u16 max_zoom_decimation { 64 };
+
+    void flush_batch();
+    void run();
+    void apply_settings(const Waterfall::Settings&, const Waterfall::GlobalSettings&, SampleRate);
+    void process(float);
+    u32 row_hop() const { return m_settings.bins / (m_settings.speed_multiplier + 1); }
+    bool averaging() const { return m_settings.averaged_frames > 1 || m_settings.peak_hold; }
+    u32 frame_hop() const;
+    void calculate_frame();
+    void calculate_row();
+    bool zooming_in() const { return m_settings.zoom > 0; }
+    void configure_zoom(u32 width);
+    void real_fft_power();
+    void zoom_fft_power();
+    u32 real_fft_pixels(u32 width, float& max);
+    u32 zoom_fft_pixels(u32 width, float& max);
+    Row take_free_row(size_t size);
+
+    Waterfall& m_waterfall;
+    std::thread m_thread;
+    std::mutex m_mutex;
+    std::condition_variable m_samples_available;
+    bool m_stop { false };
+
+    /* Owned by the processing thread */
+    Util::Buffer<float> m_batch;
+    size_t m_batch_fill { 0 };
+
+    /* Guarded by m_mutex */
+    Util::RingBuffer<float> m_input { input_capacity };
+    std::vector<Row> m_finished_rows;
+    std::vector<Row> m_free_rows;
+    /* Set from posting a wake up until the UI thread took the rows */
+    bool m_wakeup_pending { false };
+    Waterfall::Settings m_new_settings;
+    Waterfall::GlobalSettings m_new_global_settings;
+    SampleRate m_new_sample_rate { 44100 };
+    bool m_settings_changed { true };
+
+    /* Owned by the worker thread */
+    Waterfall::Settings m_settings;
+    Waterfall::GlobalSettings m_global_settings;
+    SampleRate m_sample_rate { 44100 };
+    Util::RingBuffer<float> m_samples;
+    Util::Buffer<float> m_window_coefficients;
+    FFT m_fft;
+    Util::Buffer<float> m_frame_power;
+    Util::SpectrumAverager m_averager;
+    bool m_averager_stale { true };
+    Util::Buffer<float> m_magnitudes;
+    Util::Buffer<float> m_down_sampled;
+    Util::ZoomFFT m_zoom_fft;
+    u32 m_zoom_width { 0 };
+    bool m_zoom_stale { true };
+    Util::Buffer<float> m_pixel_values;
+    Util::Buffer<u8> m_pixel_indices;
+    Palette::Table m_palette_table {};
+    u32 m_sample_count { 0 };
+    u32 m_frame_sample_count { 0 };
+    bool m_initialized { false };
+
+    std::atomic<u32> m_row_width { 0 };
+    std::atomic<bool> m_indexed_rows { false };
+};
+
+}
@@ -26,17 +26,54 @@ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 #include "TextDisplay.hpp"
+#include <Drtd.hpp>
 #include <FL/Fl.H>
+#include <algorithm>
 
 using namespace Ui;
 
 TextDisplay::TextDisplay(int x, int y, int w, int h)
     : Fl_Text_Display(x, y, w, h) {
     buffer(new Fl_Text_Buffer());
+    Fl::add_timeout(flush_interval, flush_timeout, this);
+}
+
+TextDisplay::~TextDisplay() {
+    Fl::remove_timeout(flush_timeout, this);
+}
+
+void TextDisplay::append(const char* text) {
+    m_pending += text;
+}
+
+void TextDisplay::flush_timeout(void* display) {
+    static_cast<TextDisplay*>(display)->flush();
+    Fl::repeat_timeout(flush_interval, flush_timeout, display);
+}
+
+void TextDisplay::flush() {
+    if (m_pending.empty())
+        return;
+
+    const bool autoscroll = should_autoscroll();
+    m_line_count += static_cast<u32>(std::count(m_pending.begin(), m_pending.end(), '\n'));
+    mBuffer->append(m_pending.c_str());
+    m_pending.clear();
+
+    /* Trim in chunks, so the buffer is not shifted for every new line */
+    const u32 max_lines = Drtd::max_text_lines();
+    if (m_line_count > max_lines + std::max(max_lines / 8, 1u)) {
+        const u32 remove_lines = m_line_count - max_lines;
+        mBuffer->remove(0, mBuffer->skip_lines(0, static_cast<int>(remove_lines)));
+        m_line_count -= remove_lines;
+    }
+
+    if (autoscroll)
+        scroll_to_bottom();
 }
 
 void TextDisplay::scroll_to_bottom() {
-    scroll(mBuffer->count_lines(0, mBuffer->length()), 0);
+    scroll(static_cast<int>(m_line_count), 0);
 }
 
 bool TextDisplay::should_autoscroll() {
@@ -44,5 +81,7 @@ bool TextDisplay::should_autoscroll() {
 }
 
 void TextDisplay::clear() {
+    m_pending.clear();
+    m_line_count = 0;
     mBuffer->remove(0, mBuffer->length());
 }
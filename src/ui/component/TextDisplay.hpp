@@ -29,15 +29,34 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <FL/Fl_Text_Display.H>
 #include <memory>
+#include <string>
+#include <util/Types.hpp>
 
 namespace Ui {
 
+/*
+ * Text appended from the processing thread is queued and added to the buffer a few times per second. Only the
+ * newest lines are kept, so long sessions do not slow down the display.
+ */
 class TextDisplay final : public Fl_Text_Display {
 public:
     TextDisplay(int x, int y, int w, int h);
+    virtual ~TextDisplay() override;
+
+    /* Needs the FLTK lock, like every other UI access from the processing thread */
+    void append(const char* text);
+    void append(const std::string& text) { append(text.c_str()); }
+    void clear();
 
+private:
+    static constexpr double flush_interval { 1. / 30 };
+
+    static void flush_timeout(void*);
+    void flush();
     bool should_autoscroll();
     void scroll_to_bottom();
-    void clear();
+
+    std::string m_pending;
+    u32 m_line_count { 0 };
 };
 }
@@ -26,11 +26,13 @@ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 #include "Waterfall.hpp"
+#include "GlWaterfall.hpp"
+#include "SpectrumWorker.hpp"
 
+#include <Drtd.hpp>
 #include <decoder/Decoder.hpp>
 #include <ui/WaterfallDialog.hpp>
 #include <util/Logger.hpp>
-#include <util/Resampler.hpp>
 #include <util/Util.hpp>
 
 using namespace Ui;
@@ -63,17 +65,104 @@ const Util::Buffer<Palette::WaterfallPalette>& Palette::palettes() {
     return s_palettes;
 }
 
+void Palette::build_table(u8 palette_index, Table& table) {
+    auto& palette = palettes()[palette_index];
+
+    for (size_t i = 0; i < table_size; ++i) {
+        const float normalized = static_cast<float>(i) / (table_size - 1);
+        const float float_index = Util::scale_log(normalized, 0, 1, true) * static_cast<float>(palette.color_count - 1);
+        const size_t base_index = std::min(palette.color_count - 1, static_cast<size_t>(float_index));
+        const auto base_color = palette.colors[base_index];
+        const auto mix_color = palette.colors[std::min(palette.color_count - 1, base_index + 1)];
+        const float mix_amount = float_index - static_cast<float>(base_index);
+        const float base_amount = 1 - mix_amount;
+
+        uchar base_red = 0;
+        uchar base_green = 0;
+        uchar base_blue = 0;
+
+        uchar mix_red = 0;
+        uchar mix_green = 0;
+        uchar mix_blue = 0;
+
+        Fl::get_color(base_color, base_red, base_green, base_blue);
+        Fl::get_color(mix_color, mix_red, mix_green, mix_blue);
+
+        const size_t li = i * 3;
+        table[li] = static_cast<u8>((mix_amount * mix_red) + (base_amount * base_red));
+        table[li + 1] = static_cast<u8>((mix_amount * mix_green) + (base_amount * base_green));
+        table[li + 2] = static_cast<u8>((mix_amount * mix_blue) + (base_amount * base_blue));
+    }
+}
+
 Waterfall::Waterfall(GlobalSettings settings, u32 x, u32 y, u32 w, u32 h)
     : Canvas(x, y, w, h, 2)
     , m_new_window_index(settings.window_index)
     , m_global_settings(settings)
-    , m_samples(m_settings.bins)
-    , m_window_coefficients(m_settings.bins) {
+    , m_worker(std::make_unique<SpectrumWorker>(*this)) {
     m_waterfall_layer = make_layer(0, scale_area_height, Layer::parent_size, Layer::parent_size);
     m_scale_layer = make_layer(0, 0, Layer::parent_size, scale_area_height);
-    update_settings(true);
+    update_settings();
     box(FL_DOWN_BOX);
     redraw_scale_later();
+
+    if (Drtd::opengl_waterfall() && GlWaterfall::available() && window()) {
+        /* A subwindow of the main window, so the tile the waterfall is in does not treat it as a pane */
+        auto* current_group = Fl_Group::current();
+        Fl_Group::current(nullptr);
+        const auto area = history_area();
+        m_gl_view = new GlWaterfall(*this, area.x, area.y, area.w, area.h);
+        window()->add(m_gl_view);
+        Fl_Group::current(current_group);
+
+        Palette::Table table;
+        Palette::build_table(m_global_settings.palette_index, table);
+        m_gl_view->set_palette(table);
+        m_worker->set_indexed_rows(true);
+    }
+}
+
+Waterfall::~Waterfall() = default;
+
+void Waterfall::set_palette_index(u8 index) {
+    {
+        std::unique_lock<std::mutex> lock(m_settings_mutex);
+        m_global_settings.palette_index = index;
+        m_worker->set_settings(m_settings, m_global_settings, m_sample_rate);
+    }
+
+    if (m_gl_view) {
+        Palette::Table table;
+        Palette::build_table(index, table);
+        m_gl_view->set_palette(table);
+    }
+}
+
+Waterfall::Area Waterfall::history_area() const {
+    /* Windows can not be empty */
+    return {
+        x() + padding(),
+        y() + padding() + scale_area_height,
+        std::max(w() - 2 * padding(), 1),
+        std::max(h() - 2 * padding() - scale_area_height, 1)
+    };
+}
+
+void Waterfall::resize(int x, int y, int w, int h) {
+    Canvas::resize(x, y, w, h);
+    if (m_gl_view) {
+        const auto area = history_area();
+        m_gl_view->resize(area.x, area.y, area.w, area.h);
+    }
+}
+
+void Waterfall::use_software_renderer() {
+    s_log.info() << "Using the software renderer";
+    m_gl_view->hide();
+    Fl::delete_widget(m_gl_view);
+    m_gl_view = nullptr;
+    m_worker->set_indexed_rows(false);
+    force_redraw();
 }
 
 void Waterfall::show_marker(bool show) {
@@ -108,7 +197,12 @@ void Waterfall::set_sample_rate(u16 sample_rate) {
     if (sample_rate == m_sample_rate)
         return;
 
-    m_sample_rate = sample_rate;
+    {
+        std::unique_lock<std::mutex> lock(m_settings_mutex);
+        m_sample_rate = sample_rate;
+        m_worker->set_settings(m_settings, m_global_settings, m_sample_rate);
+    }
+
     redraw_scale_later();
 }
 
@@ -116,20 +210,27 @@ int Waterfall::handle(int event) {
     if (m_scale_layer->current_width() != m_old_size.w() || m_scale_layer->current_height() != m_old_size.h())
         force_redraw();
 
+    if (handle_history_event(event, Fl::event_x() - x() - padding()))
+        return 1;
+
+    return Canvas::handle(event);
+}
+
+bool Waterfall::handle_history_event(int event, int history_x) {
     if (!m_decoder)
-        return Canvas::handle(event);
+        return false;
 
     if (Fl::event_button3() && event == FL_PUSH) {
         WaterfallDialog::show_dialog();
-        return 1;
+        return true;
     } else if (Fl::event_button1() && (event == FL_PUSH || event == FL_DRAG)) {
-        const auto freq = static_cast<Hertz>(Waterfall::translate_x_to_hz(m_settings, Fl::event_x() - x() - padding() + m_settings.bin_offset, m_sample_rate));
+        const auto freq = static_cast<Hertz>(Waterfall::translate_x_to_hz(m_settings, history_x + m_settings.bin_offset, m_sample_rate));
         if (event == FL_PUSH)
             s_log.info() << "Clicked at " << freq << " Hz";
 
         if (m_decoder->marker().moveable && m_input_limiter.limit() && m_show_marker)
             m_decoder->set_center_frequency(std::max(m_decoder->min_center_frequency(), std::min(static_cast<u16>(m_sample_rate / 2), freq)));
-        return 1;
+        return true;
     } else if (event == FL_MOUSEWHEEL) {
         auto new_settings = settings();
         auto dy = Fl::event_dy();
@@ -162,134 +263,69 @@ int Waterfall::handle(int event) {
 
         update_settings_later(new_settings);
         WaterfallDialog::load_from_waterfall(new_settings);
-        return 1;
+        return true;
     }
 
-    return Canvas::handle(event);
+    return false;
 }
 
-void Waterfall::update_settings(bool force) {
+void Waterfall::update_settings() {
     std::unique_lock<std::mutex> lock(m_settings_mutex);
-    auto bins = m_new_settings.bins;
-    bool bins_changed = bins != m_settings.bins || force;
-
-    if (bins_changed) {
-        m_samples.resize(bins);
-        m_window_coefficients = Util::Buffer<float>(bins);
-        m_fft = FFT(bins);
-    }
-
-    if (m_global_settings.window_index != m_new_window_index || bins_changed) {
-        Dsp::Window::s_windows[m_new_window_index].calculate_coefficients(m_window_coefficients);
-        m_global_settings.window_index = m_new_window_index;
-    }
-
+    m_global_settings.window_index = m_new_window_index;
     m_settings = m_new_settings;
+    m_worker->set_settings(m_settings, m_global_settings, m_sample_rate);
 }
 
 void Waterfall::process_sample(float sample) {
-    m_samples.push(sample);
-
-    if (m_sample_count < m_settings.bins / (m_settings.speed_multiplier + 1)) {
-        ++m_sample_count;
-        return;
+    if (m_update_settings) {
+        update_settings();
+        m_update_settings = false;
     }
 
-    m_sample_count = 0;
-    if (!m_waterfall_layer->current_width() || !m_waterfall_layer->current_height())
-        return;
-
-    for (size_t i = 0; i < m_settings.bins; ++i)
-        m_fft.input_buffer()[i] = m_samples.peek(i) * m_window_coefficients[i];
-
-    m_fft.execute();
-
-    float max = 0;
-    u32 downsample_index = 0;
-    auto pseudo_bins = Waterfall::pseudo_bins(m_settings);
-    bool down_sampling = Waterfall::down_sampling(m_settings);
-    Util::Resampler down_sampler(std::abs(m_settings.zoom) + 1, 1);
-    Util::Buffer<float> bin_values(down_sampling ? pseudo_bins / 2 : m_settings.bins / 2);
-
-    for (size_t i = 0; i < m_settings.bins / 2; ++i) {
-        float real = static_cast<float>(m_fft.output_buffer()[i][0]);
-        if (std::isinf(real))
-            real = 0;
+    m_worker->set_row_width(m_waterfall_layer->current_height() ? m_waterfall_layer->current_width() : 0);
+    m_worker->push_sample(sample);
+}
 
-        float imag = static_cast<float>(m_fft.output_buffer()[i][1]);
-        if (std::isinf(imag))
-            imag = 0;
+void Waterfall::on_rows_finished(void* waterfall) {
+    static_cast<Waterfall*>(waterfall)->draw_finished_rows();
+}
 
-        float magnitude = real * real + imag * imag;
-        if (!m_settings.power_spectrum)
-            magnitude = sqrtf(magnitude);
+void Waterfall::draw_finished_rows() {
+    if (m_gl_view && m_gl_view->failed())
+        use_software_renderer();
 
-        if (down_sampling) {
-            down_sampler.process_input_sample(magnitude);
-            if (down_sampler.read_output_sample(magnitude)) {
-                max = std::max(max, magnitude);
-                if (downsample_index >= bin_values.size())
-                    break;
+    std::vector<SpectrumWorker::Row> rows;
+    m_worker->take_rows(rows);
 
-                bin_values[downsample_index++] = magnitude;
-            }
-        } else {
-            bin_values[i] = magnitude;
-            max = std::max(max, magnitude);
+    if (m_gl_view) {
+        for (const auto& row : rows) {
+            if (row.indexed)
+                m_gl_view->push_row(row.pixels.ptr(), row.width);
         }
     }
 
-    Util::Buffer<u8> line_buffer(m_waterfall_layer->current_width() * 3);
-    auto& palette = Ui::Palette::palettes()[m_global_settings.palette_index];
-
-    unsigned x = 0;
-    for (size_t i = m_settings.bin_offset; i < pseudo_bins / 2 && x < m_waterfall_layer->current_width(); ++i, ++x) {
-        float value;
-        if (down_sampling || m_settings.zoom == 0)
-            value = bin_values[i];
-        else
-            value = Util::linear_interpolate(i / static_cast<float>(pseudo_bins) * m_settings.bins, bin_values);
-
-        if (std::isnan(value))
-            value = 0;
-
-        const float float_index = Util::scale_log(max == 0 ? 0 : value / max, 0, 1, true) * static_cast<float>(palette.color_count - 1);
-        const size_t base_index = static_cast<size_t>(float_index);
-        const auto base_color = palette.colors[base_index];
-        const auto mix_color = palette.colors[std::min(palette.color_count - 1, base_index + 1)];
-        const float mix_amount = float_index - static_cast<float>(base_index);
-        const float base_amount = 1 - mix_amount;
-
-        uchar base_red = 0;
-        uchar base_green = 0;
-        uchar base_blue = 0;
-
-        uchar mix_red = 0;
-        uchar mix_green = 0;
-        uchar mix_blue = 0;
-
-        Fl::get_color(base_color, base_red, base_green, base_blue);
-        Fl::get_color(mix_color, mix_red, mix_green, mix_blue);
+    const u32 width = m_waterfall_layer->current_width();
+    const u32 height = m_waterfall_layer->current_height();
+    if (!m_gl_view && !rows.empty() && width && height) {
+        /* Only the newest rows that still fit on the layer need to be drawn */
+        const u32 count = std::min(static_cast<u32>(rows.size()), height);
+        Ui::LayerDraw draw(m_waterfall_layer);
 
-        const size_t li = x * 3;
-        line_buffer[li] = static_cast<u8>((mix_amount * mix_red) + (base_amount * base_red));
-        line_buffer[li + 1] = static_cast<u8>((mix_amount * mix_green) + (base_amount * base_green));
-        line_buffer[li + 2] = static_cast<u8>((mix_amount * mix_blue) + (base_amount * base_blue));
-    }
+        fl_copy_offscreen(0, count, width, height - count, m_waterfall_layer->offscreen_buffer(), 0, 0);
+        for (u32 y = 0; y < count; ++y) {
+            const auto& row = rows[rows.size() - 1 - y];
+            if (row.indexed)
+                continue;
 
-    {
-        Ui::LayerDraw draw(m_waterfall_layer);
+            const u32 row_width = std::min(row.width, width);
 
-        fl_copy_offscreen(0, 1, m_waterfall_layer->current_width(), m_waterfall_layer->current_height() - 1, m_waterfall_layer->offscreen_buffer(), 0, 0);
-        fl_draw_image(line_buffer.ptr(), 0, 0, x, 1);
-        fl_color(FL_GRAY);
-        fl_line(x, 0, m_waterfall_layer->current_width(), 0);
+            fl_draw_image(row.pixels.ptr(), 0, y, row_width, 1);
+            fl_color(FL_GRAY);
+            fl_line(row_width, y, width, y);
+        }
     }
 
-    if (m_update_settings) {
-        update_settings(false);
-        m_update_settings = false;
-    }
+    m_worker->recycle_rows(rows);
 
     if (m_redraw_scale || m_old_width != w()) {
         redraw_scale_and_marker();
@@ -297,8 +333,12 @@ void Waterfall::process_sample(float sample) {
         m_redraw_scale = false;
     }
 
-    if (m_redraw_limiter.limit())
-        damage(FL_DAMAGE_ALL);
+    if (m_redraw_limiter.limit()) {
+        if (m_gl_view)
+            m_gl_view->redraw();
+        else
+            damage(FL_DAMAGE_ALL);
+    }
 }
 
 void Waterfall::redraw_scale_and_marker() {
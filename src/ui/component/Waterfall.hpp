@@ -28,12 +28,12 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #pragma once
 
 #include "Canvas.hpp"
+#include <array>
 #include <atomic>
 #include <dsp/Window.hpp>
-#include <util/FFT.hpp>
+#include <memory>
 #include <util/Limiter.hpp>
 #include <util/Marker.hpp>
-#include <util/RingBuffer.hpp>
 #include <util/Size.hpp>
 #include <util/Types.hpp>
 
@@ -43,14 +43,27 @@ class DecoderBase;
 
 namespace Ui {
 
+class GlWaterfall;
+class SpectrumWorker;
+
 class Waterfall final : public Canvas {
 public:
+    enum class Overlap : u8 {
+        None,
+        Half,
+        ThreeQuarters
+    };
+
     struct Settings {
         u32 bins { 4096 };
         u8 speed_multiplier { 0 };
         bool power_spectrum { false };
         float zoom { 0 };
         u32 bin_offset { 0 };
+        /* Power spectra of this many overlapping frames are averaged for each row */
+        u8 averaged_frames { 1 };
+        Overlap overlap { Overlap::Half };
+        bool peak_hold { false };
     };
 
     struct GlobalSettings {
@@ -58,7 +71,15 @@ public:
         u8 window_index { 0 };
     };
 
+    struct Area {
+        int x { 0 };
+        int y { 0 };
+        int w { 0 };
+        int h { 0 };
+    };
+
     Waterfall(GlobalSettings settings, u32 x, u32 y, u32 w, u32 h);
+    ~Waterfall();
 
     static u32 pseudo_bins(const Settings& settings) {
         return static_cast<u32>(std::roundf((down_sampling(settings) ? 1 / (std::abs(settings.zoom) + 1) : settings.zoom + 1) * settings.bins));
@@ -71,7 +92,7 @@ public:
 
     static float translate_x_to_hz(const Settings& settings, u32 x, SampleRate sample_rate) { return static_cast<float>(x) * hz_per_bin(settings, sample_rate); }
 
-    void set_palette_index(u8 index) { m_global_settings.palette_index = index; }
+    void set_palette_index(u8 index);
     void set_window_index(u8 index) {
         m_new_window_index = index;
         m_update_settings = true;
@@ -89,14 +110,25 @@ public:
     void set_decoder(std::shared_ptr<Dsp::DecoderBase>&);
     void show_marker(bool show);
     void force_redraw();
+    /* Where the rows are drawn, below the scale */
+    Area history_area() const;
+
+    virtual void resize(int x, int y, int w, int h) override;
 
 private:
+    friend class GlWaterfall;
+    friend class SpectrumWorker;
+
     static constexpr bool down_sampling(const Settings& settings) { return settings.zoom < 0; }
 
     virtual int handle(int event) override;
-    void update_settings(bool force);
+    bool handle_history_event(int event, int history_x);
+    void use_software_renderer();
+    void update_settings();
     void redraw_scale_and_marker();
     void redraw_scale_later();
+    static void on_rows_finished(void* waterfall);
+    void draw_finished_rows();
 
     u8 m_new_window_index;
     Settings m_new_settings;
@@ -104,9 +136,8 @@ private:
     GlobalSettings m_global_settings;
     std::shared_ptr<Layer> m_waterfall_layer;
     std::shared_ptr<Layer> m_scale_layer;
-    Util::RingBuffer<float> m_samples;
-    Util::Buffer<float> m_window_coefficients;
-    u32 m_sample_count { 0 };
+    std::unique_ptr<SpectrumWorker> m_worker;
+    GlWaterfall* m_gl_view { nullptr };
     int m_old_width { 0 };
     SampleRate m_sample_rate { 44100 };
     std::mutex m_settings_mutex;
@@ -115,7 +146,6 @@ private:
     Limiter m_redraw_limiter { 60 };
     Limiter m_input_limiter { 30 };
     std::shared_ptr<Dsp::DecoderBase> m_decoder;
-    FFT m_fft;
     bool m_show_marker { true };
     Size m_old_size;
 };
@@ -127,6 +157,11 @@ struct WaterfallPalette {
     size_t color_count { 0 };
 };
 
+/* Colors for normalized magnitudes from 0 to 1 on a log scale, as RGB triplets */
+static constexpr size_t table_size { 256 };
+using Table = std::array<u8, table_size * 3>;
+
 const Util::Buffer<WaterfallPalette>& palettes();
+void build_table(u8 palette_index, Table&);
 }
 }
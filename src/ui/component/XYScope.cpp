@@ -27,61 +27,109 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 #include "XYScope.hpp"
 #include <FL/fl_draw.H>
-#include <util/Point.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
 #include <optional>
+#include <util/Point.hpp>
 
 Ui::XYScope::XYScope(int x, int y, int size, WindowSize window_size, float fade_factor, bool connect)
     : Canvas(x, y, size, size, 2)
     , m_draw_layer(make_layer(0, 0, Ui::Layer::parent_size, Ui::Layer::parent_size))
-    , m_fade_factor(fade_factor)
+    , m_fade(static_cast<u16>(std::clamp(fade_factor, 0.f, 1.f) * (1 << fade_shift)))
     , m_sample_buffer(window_size)
     , m_connect(connect) {
     box(FL_DOWN_BOX);
 }
 
+void Ui::XYScope::fade_image() {
+    /* Written without branches on plain integers, so it is vectorized */
+    u8* pixels = m_image.ptr();
+    const size_t size = m_image.size();
+    const u16 fade = m_fade;
+    for (size_t i = 0; i < size; ++i)
+        pixels[i] = static_cast<u8>((pixels[i] * fade) >> fade_shift);
+}
+
+void Ui::XYScope::plot(int x, int y) {
+    if (x < 0 || y < 0 || x >= m_image_width || y >= m_image_height)
+        return;
+
+    /* FL_GREEN */
+    u8* rgb = m_image.ptr() + (x + y * m_image_width) * 3;
+    rgb[0] = 0;
+    rgb[1] = 255;
+    rgb[2] = 0;
+}
+
+void Ui::XYScope::plot_line(int from_x, int from_y, int to_x, int to_y) {
+    /* Bresenham */
+    const int dx = std::abs(to_x - from_x);
+    const int dy = -std::abs(to_y - from_y);
+    const int step_x = from_x < to_x ? 1 : -1;
+    const int step_y = from_y < to_y ? 1 : -1;
+    int error = dx + dy;
+
+    while (true) {
+        plot(from_x, from_y);
+        if (from_x == to_x && from_y == to_y)
+            break;
+
+        const int error2 = error * 2;
+        if (error2 >= dy) {
+            error += dy;
+            from_x += step_x;
+        }
+
+        if (error2 <= dx) {
+            error += dx;
+            from_y += step_y;
+        }
+    }
+}
+
 void Ui::XYScope::process(Util::Cmplx sample) {
     m_sample_buffer[m_sample_count++] = sample;
     m_max_magnitude = std::max(m_max_magnitude, sample.magnitude_squared());
 
     if (m_sample_count == m_sample_buffer.size()) {
-        const auto width = m_draw_layer->current_width();
-        const auto height = m_draw_layer->current_height();
-        Buffer<u8> offscreen_buffer(width * height * 3);
-        Ui::LayerDraw draw(m_draw_layer);
-
-        fl_read_image(offscreen_buffer.ptr(), 0, 0, width, height);
-        for (unsigned x = 0; x < width; ++x) {
-            for (unsigned y = 0; y < height; ++y) {
-                u8* rgb = offscreen_buffer.ptr() + (x + y * width) * 3;
-                rgb[0] = static_cast<u8>(rgb[0] * m_fade_factor);
-                rgb[1] = static_cast<u8>(rgb[1] * m_fade_factor);
-                rgb[2] = static_cast<u8>(rgb[2] * m_fade_factor);
-            }
+        const auto width = static_cast<int>(m_draw_layer->current_width());
+        const auto height = static_cast<int>(m_draw_layer->current_height());
+        if (width != m_image_width || height != m_image_height) {
+            m_image = Buffer<u8>(static_cast<size_t>(width * height * 3));
+            m_image_width = width;
+            m_image_height = height;
         }
 
-        fl_draw_image(offscreen_buffer.ptr(), 0, 0, width, height);
+        fade_image();
 
-        const float factor = 1 / sqrtf(m_max_magnitude);
-        const unsigned x_offset = width / 2;
-        const unsigned y_offset = height / 2;
-        const float scale = std::min(width, height) * .48f;
+        if (m_max_magnitude > 0) {
+            const float factor = 1 / sqrtf(m_max_magnitude);
+            const unsigned x_offset = width / 2;
+            const unsigned y_offset = height / 2;
+            const float scale = std::min(width, height) * .48f;
 
-        fl_color(FL_GREEN);
-        std::optional<Point> previous;
-        for (auto& to_draw : m_sample_buffer) {
-            to_draw *= factor;
-            const Point next(to_draw.real() * scale + x_offset, to_draw.imag() * scale + y_offset);
+            std::optional<Point> previous;
+            for (auto& to_draw : m_sample_buffer) {
+                to_draw *= factor;
+                const Point next(to_draw.real() * scale + x_offset, to_draw.imag() * scale + y_offset);
 
-            if (m_connect) {
-                if (previous)
-                    fl_line(previous->x(), previous->y(), next.x(), next.y());
+                if (m_connect) {
+                    if (previous)
+                        plot_line(previous->x(), previous->y(), next.x(), next.y());
 
-                previous = next;
-            } else {
-                fl_point(next.x(), next.y());
+                    previous = next;
+                } else {
+                    plot(next.x(), next.y());
+                }
             }
         }
 
+        {
+            Ui::LayerDraw draw(m_draw_layer);
+            fl_draw_image(m_image.ptr(), 0, 0, width, height);
+        }
+
         m_sample_count = 0;
         m_max_magnitude = 0;
         damage(FL_DAMAGE_ALL);
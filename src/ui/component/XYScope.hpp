@@ -39,11 +39,23 @@ public:
     void process(Cmplx);
 
 private:
+    /* Fading multiplies by m_fade and shifts right by this many bits */
+    static constexpr u8 fade_shift { 8 };
+
+    void fade_image();
+    void plot(int x, int y);
+    void plot_line(int from_x, int from_y, int to_x, int to_y);
+
     std::shared_ptr<Ui::Layer> m_draw_layer;
-    float m_fade_factor;
+    u16 m_fade;
     Buffer<Cmplx> m_sample_buffer;
     bool m_connect;
 
+    /* The persistence image is kept here, so it never has to be read back from the window system */
+    Buffer<u8> m_image;
+    int m_image_width { 0 };
+    int m_image_height { 0 };
+
     WindowSize m_sample_count { 0 };
     float m_max_magnitude { 0 };
 };
@@ -0,0 +1,64 @@
+/*
+BSD 2-Clause License
+
+Copyright (c) 2020, Till Mayer
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#pragma once
+
+#include "Types.hpp"
+#include <algorithm>
+
+namespace Util {
+
+/* Up to 64 bits passed between components at once, so bit level work can be done a word at a time */
+struct BitStream {
+    static constexpr u8 capacity { 64 };
+
+    /* The oldest bit is the lsb */
+    u64 bits { 0 };
+    u8 count { 0 };
+
+    static constexpr u64 mask(u8 bit_count) { return bit_count >= capacity ? ~static_cast<u64>(0) : (static_cast<u64>(1) << bit_count) - 1; }
+
+    bool empty() const { return count == 0; }
+    bool full() const { return count == capacity; }
+    bool get(u8 index) const { return (bits >> index) & 1; }
+    bool newest() const { return get(count - 1); }
+
+    /* Appends as many of the oldest new_count bits as fit and returns how many were taken */
+    u8 append(u64 new_bits, u8 new_count) {
+        const u8 taken = std::min<u8>(new_count, capacity - count);
+        if (taken == 0)
+            return 0;
+
+        bits |= (new_bits & mask(taken)) << count;
+        count += taken;
+        return taken;
+    }
+};
+
+}
+
+using Util::BitStream;
@@ -67,6 +67,11 @@ void Config::setup(const char* exec_path) {
                  << '"';
 }
 
+std::filesystem::path Config::path_next_to_config(const char* file_name) {
+    auto path = s_config_path;
+    return path.replace_filename(file_name);
+}
+
 void Config::load_file() {
     s_log.info() << "Loading config...";
     std::ifstream conf_stream(s_config_path, std::ios::binary);
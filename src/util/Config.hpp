@@ -34,6 +34,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <cmath>
 #include <cstdint>
 #include <cstring>
+#include <filesystem>
 #include <string>
 
 namespace Util::Config {
@@ -41,6 +42,8 @@ namespace Util::Config {
 void load_file();
 void save_all();
 void setup(const char* exec_path);
+/* For files that are kept alongside the config file */
+std::filesystem::path path_next_to_config(const char* file_name);
 
 Buffer<char>& buffer(std::string);
 bool buffers_contains(std::string);
@@ -0,0 +1,112 @@
+/*
+BSD 2-Clause License
+
+Copyright (c) 2020, Till Mayer
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#pragma once
+
+#include "Types.hpp"
+#include <array>
+#include <stddef.h>
+
+namespace Util {
+
+/*
+ * CRC-16/X.25, the frame check sequence used by HDLC and AX.25: reflected polynomial 0x1021, initial value
+ * 0xFFFF and inverted output. Running the check over a frame including its FCS leaves a fixed residue, so
+ * a frame can be checked without knowing where its data ends.
+ */
+class Crc16 final {
+public:
+    static constexpr u16 polynomial { 0x8408 };
+    static constexpr u16 initial_value { 0xFFFF };
+    static constexpr u16 good_residue { 0xF0B8 };
+    static constexpr u8 slice_count { 8 };
+
+    using Table = std::array<u16, 256>;
+    using Tables = std::array<Table, slice_count>;
+
+    /* The CRC is linear, so the effect of a flipped bit on the residue is this applied once per bit following it */
+    static constexpr u16 append_zero_bit(u16 crc) { return (crc & 1) ? (crc >> 1) ^ polynomial : crc >> 1; }
+
+    static constexpr u16 update(u16 crc, u8 byte) { return (crc >> 8) ^ s_tables[0][(crc ^ byte) & 0xFF]; }
+
+    /* Slice-by-8: table k holds the CRC of a byte followed by k zero bytes, so 8 bytes take 8 independent lookups */
+    static u16 update(u16 crc, const u8* data, size_t size) {
+        for (; size >= slice_count; size -= slice_count, data += slice_count) {
+            crc = s_tables[7][(crc ^ data[0]) & 0xFF]
+                ^ s_tables[6][(crc >> 8 ^ data[1]) & 0xFF]
+                ^ s_tables[5][data[2]]
+                ^ s_tables[4][data[3]]
+                ^ s_tables[3][data[4]]
+                ^ s_tables[2][data[5]]
+                ^ s_tables[1][data[6]]
+                ^ s_tables[0][data[7]];
+        }
+
+        while (size--)
+            crc = update(crc, *data++);
+
+        return crc;
+    }
+
+    static u16 calculate(const u8* data, size_t size) { return ~update(initial_value, data, size); }
+
+    void push(u8 byte) { m_crc = update(m_crc, byte); }
+    void push(const u8* data, size_t size) { m_crc = update(m_crc, data, size); }
+    void reset() { m_crc = initial_value; }
+    u16 value() const { return ~m_crc; }
+    u16 residue() const { return m_crc; }
+    bool has_good_residue() const { return m_crc == good_residue; }
+
+private:
+    static constexpr Tables build_tables() {
+        Tables tables {};
+        for (u16 byte = 0; byte < 256; ++byte) {
+            u16 crc = byte;
+            for (u8 bit = 0; bit < 8; ++bit)
+                crc = append_zero_bit(crc);
+
+            tables[0][byte] = crc;
+        }
+
+        for (u8 slice = 1; slice < slice_count; ++slice) {
+            for (u16 byte = 0; byte < 256; ++byte) {
+                const u16 previous = tables[slice - 1][byte];
+                tables[slice][byte] = (previous >> 8) ^ tables[0][previous & 0xFF];
+            }
+        }
+
+        return tables;
+    }
+
+    static const Tables s_tables;
+
+    u16 m_crc { initial_value };
+};
+
+inline constexpr Crc16::Tables Crc16::s_tables { Crc16::build_tables() };
+
+}
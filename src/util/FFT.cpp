@@ -25,13 +25,31 @@ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
 OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
+#include "Config.hpp"
 #include "FFT.hpp"
+#include "Logger.hpp"
+#include <algorithm>
+#include <mutex>
 
-FFT::FFT(Buffer<double> input_buffer) {
-    if (input_buffer.size()) {
-        m_fft_in = input_buffer;
-        m_fft_out = Buffer<fftw_complex>(input_buffer.size());
-        m_fft_plan = fftw_plan_dft_r2c_1d(static_cast<int>(input_buffer.size()), m_fft_in.ptr(), m_fft_out.ptr(), FFTW_ESTIMATE);
+using namespace Util;
+
+static constexpr const char* s_wisdom_file_name { ".drtd_wisdom" };
+static const Logger s_log("FFT");
+/* Only fftwf_execute is thread safe, planning has to be serialized */
+static std::mutex s_planner_mutex;
+
+FFT::FFT(size_t bins, Planning planning) {
+    if (bins) {
+        m_fft_in = Buffer<float>(bins);
+        m_fft_out = Buffer<fftwf_complex>(bins / 2 + 1);
+
+        {
+            std::lock_guard lock(s_planner_mutex);
+            m_fft_plan = fftwf_plan_dft_r2c_1d(static_cast<int>(bins), m_fft_in.ptr(), m_fft_out.ptr(), planning == Planning::Measure ? FFTW_MEASURE : FFTW_ESTIMATE);
+        }
+
+        /* Measuring overwrites the buffers */
+        std::fill(m_fft_in.begin(), m_fft_in.end(), 0);
         m_valid = true;
     }
 }
@@ -41,16 +59,72 @@ FFT::FFT(FFT&& to_move) {
 }
 
 FFT::~FFT() {
-    if (m_valid)
-        fftw_destroy_plan(m_fft_plan);
+    if (m_valid) {
+        std::lock_guard lock(s_planner_mutex);
+        fftwf_destroy_plan(m_fft_plan);
+    }
+}
+
+void FFT::load_wisdom() {
+    std::lock_guard lock(s_planner_mutex);
+    auto path = Config::path_next_to_config(s_wisdom_file_name);
+    if (fftwf_import_wisdom_from_filename(path.c_str()))
+        s_log.info() << "Loaded FFT wisdom from \"" << path.c_str() << '"';
+    else
+        s_log.info() << "No FFT wisdom found, plans will be measured on first use";
+}
+
+void FFT::save_wisdom() {
+    std::lock_guard lock(s_planner_mutex);
+    auto path = Config::path_next_to_config(s_wisdom_file_name);
+    if (!fftwf_export_wisdom_to_filename(path.c_str()))
+        s_log.warning() << "Could not save FFT wisdom to \"" << path.c_str() << '"';
 }
 
 void FFT::execute() {
     if (m_valid)
-        fftw_execute(m_fft_plan);
+        fftwf_execute(m_fft_plan);
 }
 
 FFT& FFT::operator=(FFT&& to_move) {
     swap(*this, to_move);
     return *this;
 }
+
+ComplexFFT::ComplexFFT(size_t bins, FFT::Planning planning) {
+    if (bins) {
+        m_fft_in = Buffer<fftwf_complex>(bins);
+        m_fft_out = Buffer<fftwf_complex>(bins);
+
+        {
+            std::lock_guard lock(s_planner_mutex);
+            m_fft_plan = fftwf_plan_dft_1d(static_cast<int>(bins), m_fft_in.ptr(), m_fft_out.ptr(), FFTW_FORWARD, planning == FFT::Planning::Measure ? FFTW_MEASURE : FFTW_ESTIMATE);
+        }
+
+        for (size_t i = 0; i < bins; ++i)
+            m_fft_in[i][0] = m_fft_in[i][1] = 0;
+
+        m_valid = true;
+    }
+}
+
+ComplexFFT::ComplexFFT(ComplexFFT&& to_move) {
+    swap(*this, to_move);
+}
+
+ComplexFFT::~ComplexFFT() {
+    if (m_valid) {
+        std::lock_guard lock(s_planner_mutex);
+        fftwf_destroy_plan(m_fft_plan);
+    }
+}
+
+void ComplexFFT::execute() {
+    if (m_valid)
+        fftwf_execute(m_fft_plan);
+}
+
+ComplexFFT& ComplexFFT::operator=(ComplexFFT&& to_move) {
+    swap(*this, to_move);
+    return *this;
+}
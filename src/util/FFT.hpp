@@ -35,21 +35,29 @@ namespace Util {
 
 class FFT {
 public:
+    enum class Planning {
+        /* Cheap to create, for transforms that are only executed a few times */
+        Estimate,
+        /* Times the candidate algorithms once, the result is kept in the wisdom file */
+        Measure
+    };
+
     FFT()
         : FFT(0) {
     }
 
-    explicit FFT(size_t bins)
-        : FFT(Buffer<double>(bins)) {
-    }
-    explicit FFT(Buffer<double> input_buffer);
+    explicit FFT(size_t bins, Planning planning = Planning::Measure);
     FFT(FFT&) = delete;
     FFT(FFT&& move);
     ~FFT();
 
-    Buffer<double>& input_buffer() { return m_fft_in; }
-    void set_input_buffer(Buffer<double> buffer) { m_fft_in = buffer; }
-    Buffer<fftw_complex>& output_buffer() { return m_fft_out; }
+    static void load_wisdom();
+    static void save_wisdom();
+
+    size_t bins() const { return m_fft_in.size(); }
+    Buffer<float>& input_buffer() { return m_fft_in; }
+    /* Only holds the bins() / 2 + 1 non-redundant bins of the real input */
+    Buffer<fftwf_complex>& output_buffer() { return m_fft_out; }
     void execute();
     FFT& operator=(FFT&& to_move);
 
@@ -61,12 +69,46 @@ private:
         std::swap(one.m_valid, two.m_valid);
     }
 
-    Buffer<double> m_fft_in;
-    Buffer<fftw_complex> m_fft_out;
-    fftw_plan m_fft_plan;
+    Buffer<float> m_fft_in;
+    Buffer<fftwf_complex> m_fft_out;
+    fftwf_plan m_fft_plan;
+    bool m_valid { false };
+};
+
+/* Transforms complex input, the output has the same size and starts with the positive frequencies */
+class ComplexFFT {
+public:
+    ComplexFFT()
+        : ComplexFFT(0) {
+    }
+
+    explicit ComplexFFT(size_t bins, FFT::Planning planning = FFT::Planning::Measure);
+    ComplexFFT(ComplexFFT&) = delete;
+    ComplexFFT(ComplexFFT&& move);
+    ~ComplexFFT();
+
+    size_t bins() const { return m_fft_in.size(); }
+    Buffer<fftwf_complex>& input_buffer() { return m_fft_in; }
+    Buffer<fftwf_complex>& output_buffer() { return m_fft_out; }
+    const Buffer<fftwf_complex>& output_buffer() const { return m_fft_out; }
+    void execute();
+    ComplexFFT& operator=(ComplexFFT&& to_move);
+
+private:
+    friend void swap(ComplexFFT& one, ComplexFFT& two) {
+        std::swap(one.m_fft_in, two.m_fft_in);
+        std::swap(one.m_fft_out, two.m_fft_out);
+        std::swap(one.m_fft_plan, two.m_fft_plan);
+        std::swap(one.m_valid, two.m_valid);
+    }
+
+    Buffer<fftwf_complex> m_fft_in;
+    Buffer<fftwf_complex> m_fft_out;
+    fftwf_plan m_fft_plan;
     bool m_valid { false };
 };
 
 }
 
+using Util::ComplexFFT;
 using Util::FFT;
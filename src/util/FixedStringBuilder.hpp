@@ -0,0 +1,96 @@
+/*
+BSD 2-Clause License
+
+Copyright (c) 2020, Till Mayer
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+#include <string_view>
+
+namespace Util {
+
+/* Builds a string in a buffer provided by the caller without allocating. Whatever does not fit is dropped */
+class FixedStringBuilder final {
+public:
+    FixedStringBuilder(char* buffer, size_t capacity)
+        : m_buffer(buffer)
+        , m_capacity(capacity) {
+        assert(capacity > 0);
+        m_buffer[0] = '\0';
+    }
+
+    void append(char c) {
+        if (m_length + 1 >= m_capacity) {
+            m_truncated = true;
+            return;
+        }
+
+        m_buffer[m_length++] = c;
+        m_buffer[m_length] = '\0';
+    }
+
+    void append(std::string_view string) {
+        const size_t available = m_capacity - 1 - m_length;
+        const size_t count = std::min(available, string.size());
+        std::memcpy(m_buffer + m_length, string.data(), count);
+        m_length += count;
+        m_buffer[m_length] = '\0';
+        m_truncated |= count < string.size();
+    }
+
+    __attribute__((format(printf, 2, 3))) void appendf(const char* format, ...) {
+        va_list arguments;
+        va_start(arguments, format);
+        const int written = vsnprintf(m_buffer + m_length, m_capacity - m_length, format, arguments);
+        va_end(arguments);
+
+        if (written < 0)
+            return;
+
+        if (static_cast<size_t>(written) >= m_capacity - m_length) {
+            m_truncated = true;
+            m_length = m_capacity - 1;
+        } else {
+            m_length += static_cast<size_t>(written);
+        }
+    }
+
+    const char* c_str() const { return m_buffer; }
+    size_t length() const { return m_length; }
+    bool truncated() const { return m_truncated; }
+
+private:
+    char* m_buffer;
+    size_t m_capacity;
+    size_t m_length { 0 };
+    bool m_truncated { false };
+};
+
+}
@@ -0,0 +1,78 @@
+/*
+BSD 2-Clause License
+
+Copyright (c) 2020, Till Mayer
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "SpectrumAverager.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+using namespace Util;
+
+void SpectrumAverager::reset(size_t bins, u8 frames, bool peak_hold) {
+    m_frames = std::clamp(frames, static_cast<u8>(1), max_frames);
+    m_peak_hold = peak_hold;
+    m_next_frame = 0;
+    m_filled = 0;
+
+    m_history = Buffer<float>(m_frames > 1 ? bins * m_frames : 0);
+    m_sum = Buffer<double>(m_frames > 1 ? bins : 0);
+    m_result = Buffer<float>(bins);
+}
+
+void SpectrumAverager::add(const Buffer<float>& power) {
+    assert(power.size() == m_result.size());
+    const size_t bins = m_result.size();
+    const bool first = m_filled == 0;
+    m_filled = std::min(static_cast<u8>(m_filled + 1), m_frames);
+
+    if (m_frames == 1 && !m_peak_hold) {
+        std::copy(power.ptr(), power.ptr() + bins, m_result.ptr());
+        return;
+    }
+
+    static const float peak_decay = std::pow(.5f, 1 / peak_half_life_frames);
+    float* oldest = m_history.ptr() + m_next_frame * bins;
+    const double scale = 1. / m_filled;
+
+    for (size_t i = 0; i < bins; ++i) {
+        float average = power[i];
+        if (m_frames > 1) {
+            /* The oldest frame is still 0 until the history is filled */
+            m_sum[i] += power[i] - oldest[i];
+            oldest[i] = power[i];
+            average = static_cast<float>(m_sum[i] * scale);
+        }
+
+        if (m_peak_hold && !first)
+            m_result[i] = std::max(average, m_result[i] * peak_decay);
+        else
+            m_result[i] = average;
+    }
+
+    if (m_frames > 1)
+        m_next_frame = static_cast<u8>((m_next_frame + 1) % m_frames);
+}
@@ -0,0 +1,64 @@
+/*
+BSD 2-Clause License
+
+Copyright (c) 2020, Till Mayer
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#pragma once
+
+#include "Buffer.hpp"
+#include "Types.hpp"
+
+namespace Util {
+
+/*
+ * Averages the power spectra of the last few frames (Welch's method). The sum is kept running, so adding a frame
+ * costs the same no matter how many frames are averaged. Peak hold keeps the highest average per bin and lets it
+ * decay slowly.
+ */
+class SpectrumAverager final {
+public:
+    static constexpr u8 max_frames { 32 };
+
+    void reset(size_t bins, u8 frames, bool peak_hold);
+    void add(const Buffer<float>& power);
+
+    size_t bins() const { return m_result.size(); }
+    bool empty() const { return m_filled == 0; }
+    const Buffer<float>& result() const { return m_result; }
+
+private:
+    /* The held peaks lose half their power every this many frames */
+    static constexpr float peak_half_life_frames { 16 };
+
+    Buffer<float> m_history;
+    Buffer<double> m_sum;
+    Buffer<float> m_result;
+    u8 m_frames { 1 };
+    u8 m_next_frame { 0 };
+    u8 m_filled { 0 };
+    bool m_peak_hold { false };
+};
+
+}
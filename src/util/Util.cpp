@@ -30,10 +30,11 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "Point.hpp"
 #include "Size.hpp"
 #include "Types.hpp"
-#include <FL/fl_draw.H>
 #include <algorithm>
 #include <cassert>
 #include <cmath>
+#include <limits>
+#include <sstream>
 #include <stdio.h>
 #include <stdlib.h>
 #include <array>
@@ -123,13 +124,21 @@ float Util::scale_log(float value, float source_min, float source_max, bool inve
     return invert ? 1 - result : result;
 }
 
-std::string Util::escape_ascii(char c) {
+const char* Util::ascii_escape_sequence(char c) {
     c &= 0x7F;
 
     if (c > 31 && c < 127)
-        return { c };
+        return nullptr;
     else if (c == 127)
         return "<DEL>";
 
     return ascii_escape[c];
 }
+
+std::string Util::escape_ascii(char c) {
+    const char* escape_sequence = ascii_escape_sequence(c);
+    if (escape_sequence)
+        return escape_sequence;
+
+    return { static_cast<char>(c & 0x7F) };
+}
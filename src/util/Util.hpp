@@ -28,11 +28,11 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #pragma once
 
 #include "Types.hpp"
-#include <FL/Fl.H>
 #include <cmath>
 #include <memory>
 #include <optional>
 #include <stdint.h>
+#include <string>
 
 namespace Util {
 
@@ -41,7 +41,8 @@ class Size;
 template<typename T>
 class Buffer;
 
-static const Fl_Color s_amber_color { fl_rgb_color(250, 213, 14) };
+/* fl_rgb_color(250, 213, 14) */
+static constexpr u32 s_amber_color { 0xFAD50E00 };
 
 enum class IterationDecision {
     Continue,
@@ -63,6 +64,8 @@ float db_power(float value, float reference);
 float scale_log(float value, float source_min, float source_max, bool invert = false);
 std::optional<int> parse_int(const std::string&);
 std::optional<float> parse_float(const std::string&);
+/* Returns nullptr for printable characters */
+const char* ascii_escape_sequence(char);
 std::string escape_ascii(char);
 std::string to_lower(const std::string&);
 
@@ -0,0 +1,99 @@
+/*
+BSD 2-Clause License
+
+Copyright (c) 2020, Till Mayer
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "WorkerPool.hpp"
+#include <algorithm>
+#include <cassert>
+
+using namespace Util;
+
+WorkerPool::WorkerPool(size_t thread_count) {
+    for (size_t i = 0; i < thread_count; ++i)
+        m_threads.emplace_back(&WorkerPool::work, this);
+}
+
+WorkerPool::~WorkerPool() {
+    {
+        std::lock_guard lock(m_mutex);
+        m_stopping = true;
+    }
+
+    m_jobs_available.notify_all();
+    for (auto& thread : m_threads)
+        thread.join();
+}
+
+size_t WorkerPool::default_thread_count() {
+    /* The calling thread works too */
+    return std::max(std::thread::hardware_concurrency(), 2u) - 1;
+}
+
+void WorkerPool::run(size_t job_count, const Job& job) {
+    if (job_count == 0)
+        return;
+
+    std::unique_lock lock(m_mutex);
+    assert(!m_job);
+    m_job = &job;
+    m_job_count = job_count;
+    m_next_job = 0;
+    m_finished_jobs = 0;
+    ++m_batch;
+    m_jobs_available.notify_all();
+
+    run_jobs(lock);
+    m_jobs_finished.wait(lock, [this] { return m_finished_jobs == m_job_count; });
+    m_job = nullptr;
+}
+
+void WorkerPool::run_jobs(std::unique_lock<std::mutex>& lock) {
+    while (m_job && m_next_job < m_job_count) {
+        const size_t index = m_next_job++;
+        const Job& job = *m_job;
+
+        lock.unlock();
+        job(index);
+        lock.lock();
+
+        if (++m_finished_jobs == m_job_count)
+            m_jobs_finished.notify_all();
+    }
+}
+
+void WorkerPool::work() {
+    std::unique_lock lock(m_mutex);
+    size_t seen_batch = m_batch;
+
+    while (true) {
+        m_jobs_available.wait(lock, [&] { return m_stopping || m_batch != seen_batch; });
+        if (m_stopping)
+            return;
+
+        seen_batch = m_batch;
+        run_jobs(lock);
+    }
+}
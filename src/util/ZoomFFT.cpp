@@ -0,0 +1,123 @@
+/*
+BSD 2-Clause License
+
+Copyright (c) 2020, Till Mayer
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "Util.hpp"
+#include "ZoomFFT.hpp"
+#include <cmath>
+
+using namespace Util;
+
+/* FFTW is fastest for sizes with small prime factors, so the bins are rounded up to the next 2^a * 3^b * 5^c */
+static size_t smooth_size(size_t size) {
+    for (;; ++size) {
+        size_t rest = size;
+        for (size_t factor : { 2, 3, 5 }) {
+            while (rest % factor == 0)
+                rest /= factor;
+        }
+
+        if (rest == 1)
+            return size;
+    }
+}
+
+void ZoomFFT::configure(SampleRate sample_rate, float center_frequency, u16 decimation, size_t bins, const Dsp::Window& window) {
+    assert(decimation > 0 && bins > 0);
+    bins = smooth_size(bins);
+    m_center_frequency = center_frequency;
+    m_decimation = decimation;
+    m_decimation_count = 0;
+    m_hz_per_bin = static_cast<float>(sample_rate) / static_cast<float>(decimation * bins);
+
+    const float phase_step = -two_pi_f * center_frequency / static_cast<float>(sample_rate);
+    m_oscillator = Cmplx(1, 0);
+    m_oscillator_step = Cmplx(std::cos(phase_step), std::sin(phase_step));
+
+    if (m_fft.bins() != bins) {
+        /* The size follows the width of the waterfall, measuring a plan for every new width takes too long */
+        m_fft = ComplexFFT(bins, FFT::Planning::Estimate);
+        m_window_coefficients = Buffer<float>(bins);
+        m_decimated.resize(bins);
+    } else {
+        m_decimated.clear();
+    }
+
+    window.calculate_coefficients(m_window_coefficients);
+
+    /* Windowed sinc with its cutoff a bit below the decimated nyquist frequency, scaled for unity gain at 0 Hz */
+    const size_t taps = decimation * taps_per_decimation + 1;
+    const float cutoff = .45f / static_cast<float>(decimation);
+    m_filter_coefficients = Buffer<float>(taps);
+    Dsp::Window::make(Dsp::WindowType::Blackman).calculate_coefficients(m_filter_coefficients);
+
+    float sum = 0;
+    for (size_t i = 0; i < taps; ++i) {
+        const float t = static_cast<float>(i) - static_cast<float>(taps - 1) / 2;
+        const float sinc = t == 0 ? 1 : std::sin(two_pi_f * cutoff * t) / (two_pi_f * cutoff * t);
+        m_filter_coefficients[i] *= sinc;
+        sum += m_filter_coefficients[i];
+    }
+
+    for (size_t i = 0; i < taps; ++i)
+        m_filter_coefficients[i] /= sum;
+
+    m_mixed.resize(taps);
+}
+
+void ZoomFFT::process_sample(float sample) {
+    m_mixed.push(m_oscillator * sample);
+    m_oscillator = m_oscillator * m_oscillator_step;
+
+    if (++m_decimation_count < m_decimation)
+        return;
+
+    /* The filter only has to run for the samples that are kept */
+    m_decimation_count = 0;
+    m_oscillator.normalize();
+
+    Cmplx sum;
+    for (size_t i = 0; i < m_filter_coefficients.size(); ++i)
+        sum += m_mixed.peek(i) * m_filter_coefficients[i];
+
+    m_decimated.push(sum);
+}
+
+void ZoomFFT::execute() {
+    auto& input = m_fft.input_buffer();
+    for (size_t i = 0; i < input.size(); ++i) {
+        const auto& sample = m_decimated.peek(i);
+        input[i][0] = sample.real() * m_window_coefficients[i];
+        input[i][1] = sample.imag() * m_window_coefficients[i];
+    }
+
+    m_fft.execute();
+}
+
+size_t ZoomFFT::bin_index(i64 offset) const {
+    const auto bins = static_cast<i64>(m_fft.bins());
+    return static_cast<size_t>(((offset % bins) + bins) % bins);
+}
@@ -0,0 +1,80 @@
+/*
+BSD 2-Clause License
+
+Copyright (c) 2020, Till Mayer
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#pragma once
+
+#include "Buffer.hpp"
+#include "Cmplx.hpp"
+#include "FFT.hpp"
+#include "RingBuffer.hpp"
+#include "Types.hpp"
+#include <dsp/Window.hpp>
+
+namespace Util {
+
+/*
+ * Looks at a narrow band around a center frequency with a finer resolution than a real FFT of the same size:
+ * the band is mixed down to 0 Hz, low pass filtered and decimated, and only the decimated samples are transformed.
+ */
+class ZoomFFT final {
+public:
+    ZoomFFT() = default;
+
+    /* The resolution is sample_rate / (decimation * bins), where bins might be rounded up a bit */
+    void configure(SampleRate sample_rate, float center_frequency, u16 decimation, size_t bins, const Dsp::Window& window);
+    bool configured() const { return m_fft.bins(); }
+    /* After configuring, the decimated samples first have to fill a whole frame */
+    bool ready() const { return m_decimated.is_full(); }
+    void process_sample(float sample);
+    void execute();
+
+    float center_frequency() const { return m_center_frequency; }
+    float hz_per_bin() const { return m_hz_per_bin; }
+    size_t bins() const { return m_fft.bins(); }
+    u16 decimation() const { return m_decimation; }
+    const Buffer<fftwf_complex>& output_buffer() const { return m_fft.output_buffer(); }
+    /* offset is in bins relative to the center frequency and may be negative */
+    size_t bin_index(i64 offset) const;
+
+private:
+    /* Filter taps per unit of decimation */
+    static constexpr u16 taps_per_decimation { 8 };
+
+    ComplexFFT m_fft;
+    Buffer<float> m_window_coefficients;
+    Buffer<float> m_filter_coefficients;
+    RingBuffer<Cmplx> m_mixed;
+    RingBuffer<Cmplx> m_decimated;
+    Cmplx m_oscillator { 1, 0 };
+    Cmplx m_oscillator_step { 1, 0 };
+    float m_center_frequency { 0 };
+    float m_hz_per_bin { 0 };
+    u16 m_decimation { 1 };
+    u16 m_decimation_count { 0 };
+};
+
+}
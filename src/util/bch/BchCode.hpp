@@ -29,9 +29,11 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "FFMatrix.hpp"
 #include "FiniteField.hpp"
+#include "SyndromeTable.hpp"
 #include "Z2Polynomial.hpp"
-#include <cmath>
+#include <type_traits>
 #include <util/Types.hpp>
+#include <variant>
 
 namespace Bch {
 
@@ -48,9 +50,13 @@ public:
     using Message = Z2Polynomial::Store;
     using Syndromes = std::array<Z2Polynomial, 2 * t>;
 
+    /* Small codes (like the one used by POCSAG) get corrected by a table lookup instead of solving for the error locations */
+    static constexpr bool uses_syndrome_table = n - k <= max_syndrome_table_bits;
+
     explicit Code(Z2Polynomial generator)
         : m_generator(std::move(generator))
-        , m_field(std::ceil(std::log2(n + 1))) {}
+        , m_field(FiniteField::of_exponent<field_exponent_for_length(n)>())
+        , m_syndrome_table(build_syndrome_table(m_generator)) {}
 
     Message encode(Message message) const {
         Z2Polynomial result(message);
@@ -72,6 +78,27 @@ public:
     }
 
     std::optional<Message> correct(Message code_word) const {
+        if constexpr (uses_syndrome_table) {
+            if (code_word >> n)
+                return {};
+
+            return m_syndrome_table.correct(code_word);
+        } else {
+            return correct_algebraically(code_word);
+        }
+    }
+
+private:
+    using Table = std::conditional_t<uses_syndrome_table, SyndromeTable<n, k, t>, std::monostate>;
+
+    static Table build_syndrome_table(const Z2Polynomial& generator) {
+        if constexpr (uses_syndrome_table)
+            return Table(generator.coefficients());
+        else
+            return {};
+    }
+
+    std::optional<Message> correct_algebraically(Message code_word) const {
         Z2Polynomial received(code_word);
         if (!received.is_zero() && received.degree() >= n)
             return {};
@@ -92,7 +119,8 @@ public:
             return {};
 
         u8 zeroes_found = 0;
-        for (const auto& root : m_field.primitive_roots()) {
+        for (size_t i = 0; i < m_field.element_count(); ++i) {
+            const auto root = m_field.power_of_x(i);
             Z2Polynomial sum(1);
             u8 power = 1;
 
@@ -114,7 +142,6 @@ public:
         return code_word;
     }
 
-private:
     auto build_syndrome_matrix(const Syndromes& syndromes) const {
         FFMatrix<t, t> result(m_field);
         for (u8 r = 0; r < t; ++r) {
@@ -149,6 +176,7 @@ private:
 
     Z2Polynomial m_generator;
     FiniteField m_field;
+    Table m_syndrome_table;
 };
 
 }
@@ -28,33 +28,97 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #pragma once
 
 #include "Z2Polynomial.hpp"
+#include <array>
 #include <cassert>
-#include <util/Buffer.hpp>
-#include <util/Logger.hpp>
 #include <util/Types.hpp>
+#include <util/Util.hpp>
 
 namespace Bch {
 
+static constexpr u8 max_field_exponent = 16;
+
+/* One known primitive polynomial for every GF(2^m) with m <= 16, indexed by m */
+static constexpr std::array<Z2Polynomial::Store, max_field_exponent + 1> primitive_polynomials {
+    0x0, 0x3, 0x7, 0xB, 0x13, 0x25, 0x43, 0x89, 0x11D, 0x211, 0x409, 0x805, 0x1053, 0x201B, 0x4443, 0x8003, 0x1100B
+};
+
+/* Smallest m so that a code of the given length fits into GF(2^m) */
+constexpr u8 field_exponent_for_length(size_t code_length) {
+    u8 exponent = 1;
+    while (Util::pow2(exponent) < code_length + 1)
+        ++exponent;
+
+    return exponent;
+}
+
+template<u8 exponent>
+struct FieldTables {
+    static constexpr size_t element_count = Util::pow2(exponent) - 1;
+
+    std::array<u16, element_count> roots {};         //Powers of the primitive root x
+    std::array<u16, element_count + 1> roots_log {}; //Exponent of x for every non-zero element
+    bool primitive { true };
+};
+
+template<u8 exponent>
+constexpr FieldTables<exponent> build_field_tables() {
+    FieldTables<exponent> tables;
+    const auto polynomial = primitive_polynomials[exponent];
+    Z2Polynomial::Store alpha = 1; //Use x as the primitive root of unity
+
+    for (size_t i = 0; i < tables.element_count; ++i) {
+        /* Reaching 1 again early means x does not generate the whole field */
+        if (i != 0 && alpha == 1)
+            tables.primitive = false;
+
+        tables.roots[i] = static_cast<u16>(alpha);
+        tables.roots_log[alpha] = static_cast<u16>(i);
+
+        alpha <<= 1; //times x
+        if (alpha >> exponent)
+            alpha ^= polynomial;
+    }
+
+    if (alpha != 1)
+        tables.primitive = false;
+
+    return tables;
+}
+
+/* Built at compile time, and shared by every code using a field of the same size */
+template<u8 exponent>
+inline constexpr FieldTables<exponent> field_tables = build_field_tables<exponent>();
+
 class FiniteField final {
 public:
-    FiniteField(u8 exponent);
+    template<u8 exponent>
+    static FiniteField of_exponent() {
+        static_assert(exponent > 0 && exponent <= max_field_exponent);
+        static_assert(field_tables<exponent>.primitive);
+
+        const auto& tables = field_tables<exponent>;
+        return FiniteField(exponent, tables.element_count, tables.roots.data(), tables.roots_log.data());
+    }
 
-    const Buffer<Z2Polynomial> primitive_roots() const { return m_primitive_roots; }
     size_t element_count() const { return m_element_count; }
     size_t root_exponent(const Z2Polynomial& root) const;
     Z2Polynomial multiply_roots(const Z2Polynomial& multiplier, const Z2Polynomial& multiplicand) const;
     Z2Polynomial power_of_root(const Z2Polynomial& root, u8 exponent) const;
-    Z2Polynomial power_of_x(u8 exponent) const;
+    Z2Polynomial power_of_x(size_t exponent) const;
     Z2Polynomial root_inverse(const Z2Polynomial& root) const;
     Z2Polynomial syndrome(const Z2Polynomial& polynomial, u8 n) const;
 
 private:
-    static inline Logger s_log { "Finite field" };
+    FiniteField(u8 exponent, size_t element_count, const u16* roots, const u16* roots_log)
+        : m_exponent(exponent)
+        , m_element_count(element_count)
+        , m_roots(roots)
+        , m_roots_log(roots_log) {}
 
     u8 m_exponent;
-    Buffer<Z2Polynomial> m_primitive_roots;
-    Buffer<size_t> m_primitive_roots_log;
     size_t m_element_count;
+    const u16* m_roots;
+    const u16* m_roots_log;
 };
 
 }
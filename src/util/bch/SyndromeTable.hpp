@@ -0,0 +1,123 @@
+/*
+BSD 2-Clause License
+
+Copyright (c) 2020, Till Mayer
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#pragma once
+
+#include "Z2Polynomial.hpp"
+#include <array>
+#include <cassert>
+#include <optional>
+#include <util/Types.hpp>
+
+namespace Bch {
+
+/* Codes with more check bits would need an unreasonably large table */
+static constexpr u8 max_syndrome_table_bits = 16;
+
+/*
+ * Maps the syndrome (the remainder of a received word divided by the generator) to the error pattern
+ * with at most t flipped bits causing it. As the syndrome of a word is linear in its bits, it is
+ * calculated by xor-ing one precomputed value per byte of the word, so correcting a word is a constant
+ * amount of table lookups without any allocation.
+ */
+template<u8 n, u8 k, u8 t>
+class SyndromeTable final {
+    static_assert(n > k && n - k <= max_syndrome_table_bits);
+    static_assert(n <= Z2Polynomial::coefficient_count);
+
+public:
+    using Word = Z2Polynomial::Store;
+    using Syndrome = u16;
+
+    static constexpr u8 check_bits = n - k;
+    static constexpr u8 slice_count = (n + 7) / 8;
+    static constexpr size_t syndrome_count = static_cast<size_t>(1) << check_bits;
+
+    explicit SyndromeTable(Word generator) {
+        assert((generator >> check_bits) == 1);
+
+        for (u8 slice = 0; slice < slice_count; ++slice) {
+            for (Word byte = 0; byte < 256; ++byte) {
+                const Word shifted = byte << (slice * 8);
+                m_slices[slice][byte] = shifted >> n ? 0 : remainder(shifted, generator);
+            }
+        }
+
+        add_error_patterns(0, 0, 0);
+    }
+
+    Syndrome syndrome(Word word) const {
+        Syndrome result = 0;
+        for (u8 slice = 0; slice < slice_count; ++slice)
+            result ^= m_slices[slice][(word >> (slice * 8)) & 0xFF];
+
+        return result;
+    }
+
+    std::optional<Word> correct(Word word) const {
+        const auto word_syndrome = syndrome(word);
+        if (word_syndrome == 0)
+            return word;
+
+        /* Only the syndrome 0 maps to an empty error pattern, so this marks uncorrectable words */
+        const auto error_pattern = m_error_patterns[word_syndrome];
+        if (error_pattern == 0)
+            return {};
+
+        return word ^ error_pattern;
+    }
+
+private:
+    static Syndrome remainder(Word word, Word generator) {
+        for (u8 bit = n - 1; bit >= check_bits; --bit) {
+            if ((word >> bit) & 1)
+                word ^= generator << (bit - check_bits);
+        }
+
+        return static_cast<Syndrome>(word);
+    }
+
+    void add_error_patterns(Word pattern, u8 first_bit, u8 weight) {
+        if (weight == t)
+            return;
+
+        for (u8 bit = first_bit; bit < n; ++bit) {
+            const Word with_error = pattern | (static_cast<Word>(1) << bit);
+            const auto pattern_syndrome = syndrome(with_error);
+
+            /* Two patterns of weight <= t sharing a syndrome would mean the code can't correct t errors */
+            assert(pattern_syndrome != 0 && m_error_patterns[pattern_syndrome] == 0);
+            m_error_patterns[pattern_syndrome] = with_error;
+            add_error_patterns(with_error, bit + 1, weight + 1);
+        }
+    }
+
+    std::array<std::array<Syndrome, 256>, slice_count> m_slices {};
+    std::array<Word, syndrome_count> m_error_patterns {};
+};
+
+}
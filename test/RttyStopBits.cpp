@@ -0,0 +1,140 @@
+/*
+BSD 2-Clause License
+
+Copyright (c) 2020, Till Mayer
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include <cstdio>
+#include <cstdlib>
+#include <Drtd.hpp>
+#include <decoder/rtty/BaudotDecoder.hpp>
+#include <dsp/ClockRecovery.hpp>
+#include <dsp/MovingAverage.hpp>
+#include <pipe/Line.hpp>
+#include <random>
+#include <string>
+#include <vector>
+
+/*
+ * Runs random Baudot characters through the RTTY matched filter, clock recovery and Baudot decoder, and checks the
+ * character error rate. 1.5 stop bits shift the symbol grid by half a symbol with every character, which a
+ * free running clock can not follow.
+ */
+
+/* The test does not link Drtd.cpp, and runs without a user interface */
+Drtd::UserInterface* Drtd::user_interface() { return nullptr; }
+void Drtd::monitor_sample(float) {}
+
+static constexpr SampleRate sample_rate { 1050 };
+static constexpr float baud_rate { 45.45f };
+static constexpr size_t character_count { 3000 };
+static constexpr float noise_deviation { .8f };
+static constexpr float max_error_rate { .01f };
+
+struct Character {
+    u8 code;
+    const char* text;
+};
+
+/* Only letters, so the expected text does not depend on a figures shift received correctly */
+static constexpr Character letters[] {
+    { 0x01, "E" }, { 0x03, "A" }, { 0x04, " " }, { 0x05, "S" }, { 0x06, "I" }, { 0x07, "U" }, { 0x09, "D" },
+    { 0x0A, "R" }, { 0x0B, "J" }, { 0x0C, "N" }, { 0x0D, "F" }, { 0x0E, "C" }, { 0x0F, "K" }, { 0x10, "T" },
+    { 0x11, "Z" }, { 0x12, "L" }, { 0x13, "W" }, { 0x14, "H" }, { 0x15, "Y" }, { 0x16, "P" }, { 0x17, "Q" },
+    { 0x18, "O" }, { 0x19, "B" }, { 0x1A, "G" }, { 0x1C, "M" }, { 0x1D, "X" }, { 0x1E, "V" }
+};
+
+static size_t edit_distance(const std::string& a, const std::string& b) {
+    std::vector<size_t> row(b.size() + 1);
+    for (size_t j = 0; j <= b.size(); ++j)
+        row[j] = j;
+
+    for (size_t i = 1; i <= a.size(); ++i) {
+        size_t diagonal = row[0];
+        row[0] = i;
+        for (size_t j = 1; j <= b.size(); ++j) {
+            const size_t above = row[j];
+            row[j] = std::min({ row[j] + 1, row[j - 1] + 1, diagonal + (a[i - 1] != b[j - 1]) });
+            diagonal = above;
+        }
+    }
+
+    return row[b.size()];
+}
+
+static float error_rate(float stop_bits) {
+    std::mt19937 generator(1);
+    std::uniform_int_distribution<size_t> pick_letter(0, std::size(letters) - 1);
+    std::normal_distribution<float> noise(0, noise_deviation);
+
+    /* Symbols as a level and a length in symbols, idle is mark */
+    std::vector<std::pair<bool, float>> symbols { { true, 10 } };
+    std::string expected;
+    for (size_t i = 0; i < character_count; ++i) {
+        const auto& letter = letters[pick_letter(generator)];
+        expected += letter.text;
+        symbols.push_back({ false, 1 });
+        for (u8 bit = 0; bit < 5; ++bit)
+            symbols.push_back({ (letter.code >> bit) & 1, 1 });
+        symbols.push_back({ true, stop_bits });
+    }
+    symbols.push_back({ true, 10 });
+
+    auto line = Pipe::line(Dsp::MovingAverage<float>(static_cast<Samples>(sample_rate / baud_rate)),
+                           Dsp::ClockRecovery(baud_rate, false, 0, Dsp::RttyProtocol::BaudotDecoder::character_bits));
+    int id = Pipe::GenericComponent::hidden_first_id;
+    line.init(sample_rate, id);
+
+    Dsp::RttyProtocol::BaudotDecoder decoder;
+    std::string received;
+    const float samples_per_symbol = static_cast<float>(sample_rate) / baud_rate;
+    float symbol_end = 0;
+    size_t sample = 0;
+    for (const auto& [level, length] : symbols) {
+        for (symbol_end += length * samples_per_symbol; static_cast<float>(sample) < symbol_end; ++sample) {
+            Pipe::GenericComponent::prepare_processing();
+            const BitStream stream = line.run((level ? 1.f : -1.f) + noise(generator));
+            if (Pipe::GenericComponent::did_abort_processing())
+                continue;
+
+            for (u8 bit = 0; bit < stream.count; ++bit) {
+                if (const char* text = decoder.process_bit(stream.get(bit)))
+                    received += text;
+            }
+        }
+    }
+
+    return static_cast<float>(edit_distance(expected, received)) / static_cast<float>(expected.size());
+}
+
+int main() {
+    bool passed = true;
+    for (float stop_bits : { 1.f, 1.5f, 2.f }) {
+        const float rate = error_rate(stop_bits);
+        printf("%.1f stop bits: %.2f%% character errors\n", static_cast<double>(stop_bits), static_cast<double>(rate * 100));
+        passed &= rate <= max_error_rate;
+    }
+
+    return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}